@@ -18,18 +18,21 @@
 
 #include <glad/glad.h>
 #include <cstdint>
-#include <bitset>
 #include <vector>
-#include <any>
+#include "BitSignature.hpp"
 
 class Archetype;
 
-constexpr size_t MAX_COMPONENTS = 16;
-constexpr size_t MAX_ENTITIES = 4'096;
+constexpr size_t MAX_COMPONENTS = 256; // Bits of a Signature, registering more component types throws
+constexpr size_t ENTITY_INDEX_BITS = 20; // Lower bits of an EntityId, the rest is its generation
+constexpr size_t MAX_ENTITIES = (1 << ENTITY_INDEX_BITS) - 1; // Last index is kept for INVALID_ENTITY_ID
+constexpr size_t CHUNK_SIZE = 16 * 1'024; // Bytes of a chunk, shared by all columns of an archetype
+constexpr size_t CHUNK_ALIGNMENT = 64;
 using EntityId = uint32_t;
+constexpr EntityId INVALID_ENTITY_ID = static_cast<EntityId>(-1);
 using TextureId = GLuint;
-using Signature = std::bitset<MAX_COMPONENTS>;
-using ComponentArray = std::vector<std::any>; // TODO Change to std::variant if components are < 64 bytes
+using Signature = BitSignature<MAX_COMPONENTS>;
 using ArchetypeSet = std::vector<Archetype*>;
+using ChangeVersion = uint32_t; // Version of the last write to a chunk column, see ArchetypeManager::AdvanceVersion
 
 #endif // ! ALIAS_HPP
@@ -75,6 +75,10 @@ class Application
 		static GLFWwindow* ptrWindow;
 		static glm::mat3 worldToNDCMatrix;
 		static GLint maxTextureUnits;
+
+		// Empty archetypes are reclaimed every few seconds, a few at a time
+		static constexpr double ARCHETYPE_COLLECT_INTERVAL{ 5.0 };
+		static constexpr size_t ARCHETYPE_COLLECT_BUDGET{ 8 };
 		
 		// VAOs
 		std::vector<GLuint> mModels;
@@ -8,13 +8,24 @@
  * Get the number of entity that belongs in the archetype
  * Add component to the archetype
  * Copy components from archetype to archetype
- * Stores an array of each component
+ * Copy one entity's components into many rows, for prefabs
+ * Stores entities in fixed-size chunks, each chunk holding a tightly packed column of each component
+ * Caches the archetype reached by adding or removing each component type
+ * Remembers which archetypes have an edge or a column map to it, so destroying it only tells those
+ * Caches the column map of the other moves it made, so moving an entity never has to look columns up
+ * Keeps its component indices sorted, with a flat table from component index to column
+ * Holds one value of each of its shared components, entities with other values live in another archetype
+ * Stamps the chunks it writes to with ArchetypeManager's version
+ * Enables and disables entities in place, without moving them to another archetype
+ * Components deriving from ISoAComponent are moved and copied one field at a time
  *
  * Usage:
  * ArchetypeManager will call the functions in this class.
  * Get a specific archetype from ArchetypeManager.
  * Archetype archetype = ArchetypeManager::archetypes[signature]
- * archetype.AddComponent(entityId, component)
+ * size_t row{ archetype.AddEntity(entityId) };
+ * archetype.EmplaceComponent(row, component)
+ * for (Chunk& chunk : archetype.GetChunks()) SoAArrays<Transform> transforms{ chunk.GetComponentArray<Transform>() };
  *
  * Dependencies:
  *
@@ -27,16 +38,70 @@
 #define ARCHETYPE_HPP
 
 #include <unordered_map>
+#include <vector>
+#include <array>
+#include <utility>
 #include "Alias.hpp"
+#include "Chunk.hpp"
+
+class Archetype;
+
+/**
+ * @brief Pairs of ("From" column, "To" column) shared by two archetypes
+ */
+using ColumnMap = std::vector<std::pair<size_t, size_t>>;
+
+/**
+ * @brief Pairs of (component index, value index in SharedComponentManager), sorted by component index
+ */
+using SharedValues = std::vector<std::pair<size_t, uint32_t>>;
+
+/**
+ * @brief What identifies an archetype, its components and the values of its shared components
+ */
+struct ArchetypeKey
+{
+	Signature signature;
+	SharedValues sharedValues;
+
+	bool operator==(ArchetypeKey const& rhs) const;
+};
+
+namespace std
+{
+	template <>
+	struct hash<ArchetypeKey>
+	{
+		size_t operator()(ArchetypeKey const& key) const noexcept;
+	};
+}
+
+/**
+ * @brief Cached transition to the archetype reached by adding or removing one component
+ */
+struct ArchetypeEdge
+{
+	Archetype* to{ nullptr };
+	ColumnMap columnMap;
+};
 
 class Archetype
 {
 	public:
+		static constexpr size_t INVALID_COLUMN{ static_cast<uint16_t>(-1) };
+
 		/**
 		 * @brief Constructor
 		 */
 		Archetype() = default;
-		Archetype(Signature signature);
+		Archetype(ArchetypeKey const& key);
+		~Archetype();
+
+		/**
+		 * @brief Archetypes own their components, so they can't be copied or moved
+		 */
+		Archetype(Archetype const&) = delete;
+		Archetype& operator=(Archetype const&) = delete;
 
 		/**
 		 * @brief Get the signature of the archetype
@@ -44,6 +109,28 @@ class Archetype
 		 */
 		Signature GetSignature() const;
 
+		/**
+		 * @brief Get the value index of each shared component of the archetype
+		 */
+		SharedValues const& GetSharedValues() const;
+
+		/**
+		 * @brief Get the signature and shared values that identify the archetype
+		 */
+		ArchetypeKey GetKey() const;
+
+		/**
+		 * @brief Get the value of a shared component, the same for every entity of the archetype
+		 * @return Pointer to the value, or nullptr if the archetype doesn't have the shared component
+		 */
+		template <typename T>
+		T const* GetSharedComponent() const;
+
+		/**
+		 * @brief Get the indices of the archetype's components, in ascending order. Column i holds component i of this list.
+		 */
+		std::vector<size_t> const& GetComponentIds() const;
+
 		/**
 		 * @brief Get the number of entities that belong in this archetype
 		 * @return Number of entities
@@ -51,64 +138,243 @@ class Archetype
 		size_t GetEntityCount() const;
 
 		/**
-		 * @brief Adds an entity to Archetype
+		 * @brief Adds an entity to Archetype. The components of the new row are not constructed yet,
+		 * every column has to be filled with EmplaceComponent or MoveComponents.
 		 * @param entityId Entity member id
+		 * @return Row of the entity
 		 */
-		void AddEntity(EntityId entityId);
+		size_t AddEntity(EntityId entityId);
 
 		/**
-		 * @brief Removes an entity from Archetype
-		 * @param entityId Entity member id
+		 * @brief Make room for more entities so that adding them doesn't reallocate
+		 * @param count Number of entities that will be added
 		 */
-		void RemoveEntity(EntityId entityId);
+		void Reserve(size_t count);
 
 		/**
-		 * @brief Set component of an entity
-		 * @param entityId Entity member id
+		 * @brief Removes an entity from Archetype. The last entity fills the hole
+		 * and its EntityRecord is updated. An archetype left empty is kept for reuse
+		 * until ArchetypeManager::CollectEmptyArchetypes reclaims it.
+		 * @param row Row of the entity
+		 */
+		void RemoveEntity(size_t row);
+
+		/**
+		 * @brief Get the entity stored in a row
+		 * @param[in] row Row of the entity
+		 * @return Entity member id
+		 */
+		EntityId GetEntityId(size_t row) const;
+
+		/**
+		 * @brief Get the entity of every row, in row order
+		 * @return Pointer to the entity of row 0, valid for GetEntityCount() entities until the next structural change
+		 */
+		EntityId const* GetEntityIds() const;
+
+		/**
+		 * @brief Construct the component of a newly added entity
+		 * @param row Row of the entity
 		 * @param component rvalue reference to a component
 		 */
 		template <typename T>
-		void SetComponent(EntityId entityId, T&& component);
+		void EmplaceComponent(size_t row, T&& component);
 
 		/**
-		 * @brief Get the reference to the component of an entity
-		 * @param[in] entityId Entity member id
-		 * @param[in] componentSignature Signature of component of type T
+		 * @brief Construct the component of a newly added entity in a known column
+		 * @param row Row of the entity
+		 * @param column Index of the column, from GetColumnIndex
+		 * @param component rvalue reference to a component
 		 */
 		template <typename T>
-		T* GetComponent(EntityId entityId, Signature componentSignature);
+		void EmplaceComponent(size_t row, size_t column, T&& component);
 
 		/**
-		 * @brief Get component array of type T
-		 * @return Reference to component array
+		 * @brief Set component of an entity
+		 * @param row Row of the entity
+		 * @param component rvalue reference to a component
 		 */
 		template <typename T>
-		ComponentArray& GetComponentArray();
-		ComponentArray& GetComponentArray(Signature componentSignature);
+		void SetComponent(size_t row, T&& component);
 
 		/**
-		 * @brief Copy component data from an archetype to another
-		 * @param entityId Entity member id
+		 * @brief Get the reference to the component of an entity. Marks the chunk as changed unless T is const.
+		 * @param[in] row Row of the entity
+		 * @param[in] componentIndex Index of component of type T
+		 */
+		template <typename T>
+		ComponentPointer<T> GetComponent(size_t row, size_t componentIndex);
+
+		/**
+		 * @brief Get the chunks of the archetype. Only the last chunk may be partially filled.
+		 * @return Reference to the vector of chunks
+		 */
+		std::vector<Chunk>& GetChunks();
+
+		/**
+		 * @brief Get the number of entities a single chunk can hold
+		 */
+		size_t GetChunkCapacity() const;
+
+		/**
+		 * @brief Get the index of a component's column
+		 * @param[in] componentIndex Index of the component, from ComponentManager::GetComponentIndex
+		 * @return Index of the column, or INVALID_COLUMN if the archetype doesn't have the component
+		 */
+		size_t GetColumnIndex(size_t componentIndex) const;
+
+		/**
+		 * @brief Get the type-erased information of a column
+		 * @param[in] column Index of the column
+		 */
+		ComponentInfo const& GetColumnInfo(size_t column) const;
+
+		/**
+		 * @brief Get the address of a component
+		 * @param[in] index Index of the entity in the archetype
+		 * @param[in] column Index of the column
+		 */
+		void* GetComponentAddress(size_t index, size_t column);
+
+		/**
+		 * @brief Check if an entity is enabled
+		 * @param[in] row Row of the entity
+		 */
+		bool IsEnabled(size_t row);
+
+		/**
+		 * @brief Enable or disable an entity. The entity stays in its row, so references to it stay valid.
+		 * Every column of its chunk is stamped, readers that skip unchanged chunks see it appear or disappear.
+		 * @param row Row of the entity
+		 * @param isEnabled New state of the entity
+		 */
+		void SetEnabled(size_t row, bool isEnabled);
+
+		/**
+		 * @brief Move component data from an archetype to another. The entity keeps its enabled state.
+		 * Trivially copyable components are relocated with memcpy, the others with their move constructor.
+		 * @param row Row of the entity in this archetype
 		 * @param to Pointer to the archetype
+		 * @param toRow Row of the entity in "to" archetype
+		 * @param columnMap Columns shared by both archetypes, from MapColumns
+		 */
+		void MoveComponents(size_t row, Archetype* to, size_t toRow, ColumnMap const& columnMap);
+
+		/**
+		 * @brief Copy the components of an entity into rows of another archetype, one column at a time.
+		 * Trivially copyable columns are copied with memcpy. Components deriving from IComponent are given their new owner.
+		 * @param row Row of the entity to copy in this archetype
+		 * @param to Pointer to the archetype
+		 * @param toRow First row of "to" to copy into, its components are not constructed yet
+		 * @param count Number of rows to copy into, starting at toRow
+		 * @param columnMap Columns shared by both archetypes, from MapColumns
+		 */
+		void CopyComponents(size_t row, Archetype* to, size_t toRow, size_t count, ColumnMap const& columnMap);
+
+		/**
+		 * @brief Pair up the columns this archetype shares with another
+		 * @param[in] to Archetype the components will be moved to
+		 * @return Pairs of ("From" column, "To" column)
+		 */
+		ColumnMap MapColumns(Archetype const& to) const;
+
+		/**
+		 * @brief Get the columns this archetype shares with another, mapped on first use and then cached.
+		 * For moves that don't follow an add or remove edge.
+		 * @param[in] to Archetype the components will be moved to
+		 * @return Pairs of ("From" column, "To" column), valid until either archetype is destroyed
+		 */
+		ColumnMap const& GetColumnMap(Archetype& to);
+
+		/**
+		 * @brief Forget the cached column maps to and from this archetype, when it is destroyed.
+		 * Only the archetypes that cached a map to this one are told.
+		 */
+		void UnlinkColumnMaps();
+
+		/**
+		 * @brief Get the cached edge for adding a component. Edge is empty until ArchetypeManager links it.
+		 * @param[in] componentIndex Index of the component
+		 */
+		ArchetypeEdge& GetAddEdge(size_t componentIndex);
+
+		/**
+		 * @brief Get the cached edge for removing a component. Edge is empty until ArchetypeManager links it.
+		 * @param[in] componentIndex Index of the component
 		 */
-		void MoveComponents(EntityId entityId, Archetype* to);
+		ArchetypeEdge& GetRemoveEdge(size_t componentIndex);
 
-		size_t GetIndexFromEntityId(EntityId entityId);
+		/**
+		 * @brief Get the edges that were linked for adding components, by component index
+		 */
+		std::unordered_map<size_t, ArchetypeEdge> const& GetAddEdges() const;
 
 		/**
-		 * @brief Displays the component vectors
+		 * @brief Get the edges that were linked for removing components, by component index
+		 */
+		std::unordered_map<size_t, ArchetypeEdge> const& GetRemoveEdges() const;
+
+		/**
+		 * @brief Point one of this archetype's edges at another archetype and map their columns.
+		 * The other archetype remembers the edge, so it can be unlinked when either of them is destroyed.
+		 * @param edge Edge owned by this archetype, from GetAddEdge or GetRemoveEdge
+		 * @param to Archetype the edge leads to
+		 */
+		void LinkEdge(ArchetypeEdge& edge, Archetype* to);
+
+		/**
+		 * @brief Forget the edges to and from this archetype, when it is destroyed.
+		 * Only the archetypes with an edge to this one are told.
+		 */
+		void UnlinkEdges();
+
+		/**
+		 * @brief Displays the chunks of the archetype
 		 */
 		void PrintArchetype() const;
 
 	private:
+		/**
+		 * @brief Get the chunk of an entity
+		 * @param[in] index Index of the entity in the archetype
+		 */
+		Chunk& GetChunk(size_t index);
+
+		/**
+		 * @brief Copy a component stored field by field, one field at a time
+		 * @param info Information of the component's column
+		 * @param destination Address of the first field to write
+		 * @param destinationStride Bytes between two fields of the destination
+		 * @param source Address of the first field to read
+		 * @param sourceStride Bytes between two fields of the source, sizeof the field for a whole component
+		 */
+		static void CopyFields(ComponentInfo const& info, void* destination, size_t destinationStride, void const* source, size_t sourceStride);
+
+		/**
+		 * @brief Stamp the column of an entity's chunk with the current version
+		 * @param[in] index Index of the entity in the archetype
+		 * @param[in] column Index of the column
+		 */
+		void MarkChanged(size_t index, size_t column);
+
 		Signature mSignature{0};
-		std::unordered_map<Signature, ComponentArray> mSignatureToComponentArrMap;
-		std::unordered_map<EntityId, size_t> mEntityIdToIndexMap;
-		std::unordered_map<size_t, EntityId> mIndexToEntityIdMap;
+		size_t mChunkCapacity{0};
+		std::vector<ChunkColumn> mColumns;
+		SharedValues mSharedValues;
+		std::vector<size_t> mComponentIds; // Sorted, same components as mSignature
+		std::array<uint16_t, MAX_COMPONENTS> mComponentToColumn; // INVALID_COLUMN for components the archetype doesn't have
+		std::vector<Chunk> mChunks;
+		std::vector<EntityId> mEntityIds; // Entity of every row
+		std::unordered_map<size_t, ArchetypeEdge> mAddEdges; // Only the components that were actually added or removed
+		std::unordered_map<size_t, ArchetypeEdge> mRemoveEdges;
+		std::unordered_map<Archetype*, ColumnMap> mColumnMaps; // Moves that don't follow an edge
+		std::vector<Archetype*> mColumnMapSources; // Archetypes that cached a column map to this one
+		std::vector<Archetype*> mEdgeSources; // Archetypes with an edge to this one, once per edge
 };
 
 std::ostream& operator<<(std::ostream& os, Archetype const& archetype);
 
 #include "Archetype.ipp"
+#include "Chunk.ipp"
 
 #endif // ! ARCHETYPE_HPP
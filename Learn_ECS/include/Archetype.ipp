@@ -1,44 +1,115 @@
 #include <iostream>
+#include <utility>
 #include "Managers/ComponentManager.hpp"
+#include "Components/MonoBehaviour.hpp"
+#include "Managers/SharedComponentManager.hpp"
 
 /**
- * @brief Set component of an entity
- * @param entityId Entity member id
+ * @brief Get the value of a shared component, the same for every entity of the archetype
+ * @return Pointer to the value, or nullptr if the archetype doesn't have the shared component
+ */
+template <typename T>
+T const* Archetype::GetSharedComponent() const
+{
+	static_assert(IsSharedComponent<T>, "Only types deriving from ISharedComponent have shared values.");
+	size_t componentIndex{ ComponentManager::GetComponentIndex<T>() };
+	for (auto const& [sharedIndex, valueIndex] : mSharedValues)
+	{
+		if (sharedIndex == componentIndex)
+			return &SharedComponentManager::GetInstance().GetValue<std::remove_const_t<T>>(valueIndex);
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Construct the component of a newly added entity
+ * @param row Row of the entity
  * @param component rvalue reference to a component
  */
 template <typename T>
-void Archetype::SetComponent(EntityId entityId, T&& component)
+void Archetype::EmplaceComponent(size_t row, T&& component)
 {
-	Signature componentSignature{ ComponentManager::GetInstance().GetSignature<T>() };
-	auto itComponent{ mSignatureToComponentArrMap.find(componentSignature) };
-	if (itComponent == std::end(mSignatureToComponentArrMap))
+	using Component = std::decay_t<T>;
+	size_t componentIndex{ ComponentManager::GetComponentIndex<Component>() };
+	size_t column{ GetColumnIndex(componentIndex) };
+	if (column == INVALID_COLUMN)
 	{
-		std::cout << __FUNCTION__ << " Component (" << componentSignature << ": " << typeid(T).name() << ") not found.\n";
+		std::cout << __FUNCTION__ << " Component (" << componentIndex << ": " << typeid(T).name() << ") not found.\n";
 		return;
 	}
-	mSignatureToComponentArrMap[componentSignature][mEntityIdToIndexMap[entityId]] = std::move(component);
+
+	EmplaceComponent(row, column, std::move(component));
 }
 
 /**
- * @brief Get the reference to the component of an entity
- * @param[in] entityId Entity member id
- * @param[in] componentSignature Signature of component of type T
+ * @brief Construct the component of a newly added entity in a known column
+ * @param row Row of the entity
+ * @param column Index of the column, from GetColumnIndex
+ * @param component rvalue reference to a component
  */
 template <typename T>
-T* Archetype::GetComponent(EntityId entityId, Signature componentSignature)
+void Archetype::EmplaceComponent(size_t row, size_t column, T&& component)
 {
-	if ((componentSignature & mSignature) == 0) return nullptr;
-	size_t index{ mEntityIdToIndexMap[entityId] };
-	return &std::any_cast<T&>(mSignatureToComponentArrMap[componentSignature][index]);
+	using Component = std::decay_t<T>;
+	if constexpr (IsTagComponent<Component>) return;
+
+	void* address{ GetComponentAddress(row, column) };
+	if constexpr (IsSoAComponent<Component>)
+		CopyFields(*mColumns[column].info, address, sizeof(typename SoALayout<Component>::Field) * mChunkCapacity,
+			&component, sizeof(typename SoALayout<Component>::Field));
+	else if constexpr (std::is_base_of_v<MonoBehaviour, Component>)
+		new (address) ComponentStorage<Component>{ std::make_unique<Component>(std::move(component)) };
+	else
+		new (address) Component(std::move(component));
 }
 
 /**
- * @brief Get component array of type T
- * @return Reference to component array
+ * @brief Set component of an entity
+ * @param row Row of the entity
+ * @param component rvalue reference to a component
  */
 template <typename T>
-ComponentArray& Archetype::GetComponentArray()
+void Archetype::SetComponent(size_t row, T&& component)
 {
-	Signature componentSignature{ ComponentManager::GetInstance().GetSignature<T>() };
-	return GetComponentArray(componentSignature);
+	using Component = std::decay_t<T>;
+	size_t componentIndex{ ComponentManager::GetComponentIndex<Component>() };
+	size_t column{ GetColumnIndex(componentIndex) };
+	if (column == INVALID_COLUMN)
+	{
+		std::cout << __FUNCTION__ << " Component (" << componentIndex << ": " << typeid(T).name() << ") not found.\n";
+		return;
+	}
+	if constexpr (IsTagComponent<Component>) return;
+
+	if constexpr (IsSoAComponent<Component>)
+	{
+		// Fields are trivially copyable, overwriting them is the same as constructing them
+		EmplaceComponent(row, column, std::move(component));
+		MarkChanged(row, column);
+		return;
+	}
+
+	auto* storage{ static_cast<ComponentStorage<Component>*>(GetComponentAddress(row, column)) };
+	if constexpr (std::is_base_of_v<MonoBehaviour, Component>)
+		*storage = std::make_unique<Component>(std::move(component));
+	else
+		*storage = std::move(component);
+	MarkChanged(row, column);
+}
+
+/**
+ * @brief Get the reference to the component of an entity. Marks the chunk as changed unless T is const.
+ * @param[in] row Row of the entity
+ * @param[in] componentIndex Index of component of type T
+ */
+template <typename T>
+ComponentPointer<T> Archetype::GetComponent(size_t row, size_t componentIndex)
+{
+	size_t column{ GetColumnIndex(componentIndex) };
+	if (column == INVALID_COLUMN) return nullptr;
+
+	// The caller may write through the pointer, unless it asked for a const component
+	if constexpr (!std::is_const_v<T>)
+		MarkChanged(row, column);
+	return ComponentAccess<T>::MakePointer(GetComponentAddress(row, column), mColumns[column].info->fieldSize * mChunkCapacity);
 }
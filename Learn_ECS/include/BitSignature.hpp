@@ -0,0 +1,160 @@
+/*************************************************************//**
+ * @file   BitSignature.hpp
+ * @brief  Fixed-size set of component indices, one bit per component type.
+ *
+ * Key features:
+ * Drop-in for the subset of std::bitset the ECS uses (set, reset, test, any, none, & | ~ ==)
+ * Stored as 64-bit words so it scales to hundreds of component types
+ * SIMD subset and intersection tests for query matching and system conflicts
+ * Word-wise hash for archetype lookups
+ * Iterate the set indices in ascending order
+ * CountTrailingZeros finds the lowest set bit of any 64-bit word, Chunk's enabled bits use it too
+ *
+ * Usage:
+ * Signature signature{ ComponentManager::GetSignature<Transform>() };
+ * if (archetypeSignature.Contains(querySignature)) ...
+ * signature.ForEachIndex([](size_t componentIndex) { ... });
+ *
+ * Dependencies:
+ * SSE2 is used when the compiler targets it, plain word loops otherwise.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef BIT_SIGNATURE_HPP
+#define BIT_SIGNATURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <functional>
+#include <ostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BIT_SIGNATURE_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Index of the lowest set bit of a non-zero word
+ */
+inline size_t CountTrailingZeros(uint64_t word);
+
+template <size_t Bits>
+class BitSignature
+{
+	public:
+		static constexpr size_t WORD_BITS{ 64 };
+		static constexpr size_t WORD_COUNT{ (Bits + WORD_BITS - 1) / WORD_BITS };
+
+		/**
+		 * @brief Constructor. Every bit is cleared.
+		 */
+		constexpr BitSignature();
+
+		/**
+		 * @brief Constructor. Sets the lowest 64 bits, like std::bitset
+		 * @param[in] bits Value of the first word
+		 */
+		explicit constexpr BitSignature(uint64_t bits);
+
+		/**
+		 * @brief Set a bit
+		 * @param[in] index Index of the component
+		 */
+		BitSignature& set(size_t index);
+
+		/**
+		 * @brief Clear a bit
+		 * @param[in] index Index of the component
+		 */
+		BitSignature& reset(size_t index);
+
+		/**
+		 * @brief Check if a bit is set
+		 * @param[in] index Index of the component
+		 */
+		bool test(size_t index) const;
+
+		/**
+		 * @brief Check if any bit is set
+		 */
+		bool any() const;
+
+		/**
+		 * @brief Check if no bit is set
+		 */
+		bool none() const;
+
+		/**
+		 * @brief Check if every bit of another signature is also set in this one
+		 * @param[in] subset Signature to look for, e.g. the components of a query
+		 */
+		bool Contains(BitSignature const& subset) const;
+
+		/**
+		 * @brief Check if both signatures share at least one bit
+		 * @param[in] other Signature to compare with
+		 */
+		bool Intersects(BitSignature const& other) const;
+
+		/**
+		 * @brief Get the lowest set index
+		 * @return Index of the component, or Bits if the signature is empty
+		 */
+		size_t FindFirst() const;
+
+		/**
+		 * @brief Call func(index) for every set bit, in ascending order
+		 */
+		template <typename Func>
+		void ForEachIndex(Func&& func) const;
+
+		/**
+		 * @brief Hash of the words, for unordered containers
+		 */
+		size_t GetHash() const;
+
+		BitSignature& operator&=(BitSignature const& rhs);
+		BitSignature& operator|=(BitSignature const& rhs);
+		BitSignature operator~() const;
+
+		friend BitSignature operator&(BitSignature lhs, BitSignature const& rhs) { return lhs &= rhs; }
+		friend BitSignature operator|(BitSignature lhs, BitSignature const& rhs) { return lhs |= rhs; }
+		friend bool operator==(BitSignature const& lhs, BitSignature const& rhs) { return lhs.mWords == rhs.mWords; }
+		friend bool operator!=(BitSignature const& lhs, BitSignature const& rhs) { return lhs.mWords != rhs.mWords; }
+
+	private:
+		// Bits past the last component stay cleared, so whole words compare and hash correctly
+		static constexpr uint64_t LAST_WORD_MASK{ Bits % WORD_BITS ? (uint64_t{ 1 } << Bits % WORD_BITS) - 1 : ~uint64_t{ 0 } };
+
+		alignas(16) std::array<uint64_t, WORD_COUNT> mWords;
+};
+
+/**
+ * @brief Print the set indices, e.g. {0, 3, 130}
+ */
+template <size_t Bits>
+std::ostream& operator<<(std::ostream& os, BitSignature<Bits> const& signature);
+
+namespace std
+{
+	template <size_t Bits>
+	struct hash<BitSignature<Bits>>
+	{
+		size_t operator()(BitSignature<Bits> const& signature) const noexcept
+		{
+			return signature.GetHash();
+		}
+	};
+}
+
+#include "BitSignature.ipp"
+
+#endif // !BIT_SIGNATURE_HPP
@@ -0,0 +1,220 @@
+/**
+ * @brief Constructor. Every bit is cleared.
+ */
+template <size_t Bits>
+constexpr BitSignature<Bits>::BitSignature() :
+	mWords{}
+{}
+
+/**
+ * @brief Constructor. Sets the lowest 64 bits, like std::bitset
+ * @param[in] bits Value of the first word
+ */
+template <size_t Bits>
+constexpr BitSignature<Bits>::BitSignature(uint64_t bits) :
+	mWords{ WORD_COUNT == 1 ? bits & LAST_WORD_MASK : bits }
+{}
+
+/**
+ * @brief Set a bit
+ * @param[in] index Index of the component
+ */
+template <size_t Bits>
+BitSignature<Bits>& BitSignature<Bits>::set(size_t index)
+{
+	mWords[index / WORD_BITS] |= uint64_t{ 1 } << index % WORD_BITS;
+	return *this;
+}
+
+/**
+ * @brief Clear a bit
+ * @param[in] index Index of the component
+ */
+template <size_t Bits>
+BitSignature<Bits>& BitSignature<Bits>::reset(size_t index)
+{
+	mWords[index / WORD_BITS] &= ~(uint64_t{ 1 } << index % WORD_BITS);
+	return *this;
+}
+
+/**
+ * @brief Check if a bit is set
+ * @param[in] index Index of the component
+ */
+template <size_t Bits>
+bool BitSignature<Bits>::test(size_t index) const
+{
+	return (mWords[index / WORD_BITS] >> index % WORD_BITS) & 1;
+}
+
+/**
+ * @brief Check if any bit is set
+ */
+template <size_t Bits>
+bool BitSignature<Bits>::any() const
+{
+	uint64_t bits{ 0 };
+	for (uint64_t word : mWords)
+		bits |= word;
+	return bits != 0;
+}
+
+/**
+ * @brief Check if no bit is set
+ */
+template <size_t Bits>
+bool BitSignature<Bits>::none() const
+{
+	return !any();
+}
+
+/**
+ * @brief Check if every bit of another signature is also set in this one
+ * @param[in] subset Signature to look for, e.g. the components of a query
+ */
+template <size_t Bits>
+bool BitSignature<Bits>::Contains(BitSignature const& subset) const
+{
+	size_t i{ 0 };
+#ifdef BIT_SIGNATURE_SSE2
+	// Two words at a time, bits of the subset that are missing here must all be zero
+	__m128i missing{ _mm_setzero_si128() };
+	for (; i + 2 <= WORD_COUNT; i += 2)
+	{
+		__m128i words{ _mm_load_si128(reinterpret_cast<__m128i const*>(&mWords[i])) };
+		__m128i subsetWords{ _mm_load_si128(reinterpret_cast<__m128i const*>(&subset.mWords[i])) };
+		missing = _mm_or_si128(missing, _mm_andnot_si128(words, subsetWords));
+	}
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(missing, _mm_setzero_si128())) != 0xFFFF) return false;
+#endif
+	uint64_t missingBits{ 0 };
+	for (; i < WORD_COUNT; ++i)
+		missingBits |= subset.mWords[i] & ~mWords[i];
+	return missingBits == 0;
+}
+
+/**
+ * @brief Check if both signatures share at least one bit
+ * @param[in] other Signature to compare with
+ */
+template <size_t Bits>
+bool BitSignature<Bits>::Intersects(BitSignature const& other) const
+{
+	size_t i{ 0 };
+#ifdef BIT_SIGNATURE_SSE2
+	__m128i shared{ _mm_setzero_si128() };
+	for (; i + 2 <= WORD_COUNT; i += 2)
+	{
+		__m128i words{ _mm_load_si128(reinterpret_cast<__m128i const*>(&mWords[i])) };
+		__m128i otherWords{ _mm_load_si128(reinterpret_cast<__m128i const*>(&other.mWords[i])) };
+		shared = _mm_or_si128(shared, _mm_and_si128(words, otherWords));
+	}
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(shared, _mm_setzero_si128())) != 0xFFFF) return true;
+#endif
+	uint64_t sharedBits{ 0 };
+	for (; i < WORD_COUNT; ++i)
+		sharedBits |= mWords[i] & other.mWords[i];
+	return sharedBits != 0;
+}
+
+/**
+ * @brief Get the lowest set index
+ * @return Index of the component, or Bits if the signature is empty
+ */
+template <size_t Bits>
+size_t BitSignature<Bits>::FindFirst() const
+{
+	for (size_t i{}; i < WORD_COUNT; ++i)
+	{
+		if (mWords[i])
+			return i * WORD_BITS + CountTrailingZeros(mWords[i]);
+	}
+	return Bits;
+}
+
+/**
+ * @brief Call func(index) for every set bit, in ascending order
+ */
+template <size_t Bits>
+template <typename Func>
+void BitSignature<Bits>::ForEachIndex(Func&& func) const
+{
+	for (size_t i{}; i < WORD_COUNT; ++i)
+	{
+		// Clear the lowest bit until the word is empty, only set bits cost anything
+		for (uint64_t word{ mWords[i] }; word; word &= word - 1)
+			func(i * WORD_BITS + CountTrailingZeros(word));
+	}
+}
+
+/**
+ * @brief Hash of the words, for unordered containers
+ */
+template <size_t Bits>
+size_t BitSignature<Bits>::GetHash() const
+{
+	// Most signatures only use the first word, mix each word so the others still count
+	uint64_t hash{ 0 };
+	for (uint64_t word : mWords)
+	{
+		hash ^= word + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+		hash *= 0xFF51AFD7ED558CCDull;
+	}
+	return static_cast<size_t>(hash ^ (hash >> 32));
+}
+
+template <size_t Bits>
+BitSignature<Bits>& BitSignature<Bits>::operator&=(BitSignature const& rhs)
+{
+	for (size_t i{}; i < WORD_COUNT; ++i)
+		mWords[i] &= rhs.mWords[i];
+	return *this;
+}
+
+template <size_t Bits>
+BitSignature<Bits>& BitSignature<Bits>::operator|=(BitSignature const& rhs)
+{
+	for (size_t i{}; i < WORD_COUNT; ++i)
+		mWords[i] |= rhs.mWords[i];
+	return *this;
+}
+
+template <size_t Bits>
+BitSignature<Bits> BitSignature<Bits>::operator~() const
+{
+	BitSignature result;
+	for (size_t i{}; i < WORD_COUNT; ++i)
+		result.mWords[i] = ~mWords[i];
+	result.mWords[WORD_COUNT - 1] &= LAST_WORD_MASK;
+	return result;
+}
+
+/**
+ * @brief Index of the lowest set bit of a non-zero word
+ */
+inline size_t CountTrailingZeros(uint64_t word)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#else
+	return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+/**
+ * @brief Print the set indices, e.g. {0, 3, 130}
+ */
+template <size_t Bits>
+std::ostream& operator<<(std::ostream& os, BitSignature<Bits> const& signature)
+{
+	os << '{';
+	bool isFirst{ true };
+	signature.ForEachIndex([&](size_t index)
+	{
+		os << (isFirst ? "" : ", ") << index;
+		isFirst = false;
+	});
+	return os << '}';
+}
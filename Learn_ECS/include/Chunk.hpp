@@ -0,0 +1,221 @@
+/*************************************************************//**
+ * @file   Chunk.hpp
+ * @brief  Fixed-size block of memory holding the components of a group of entities.
+ *
+ * Key features:
+ * Stores every column of an archetype for up to GetCapacity() entities
+ * Columns are laid out one after another inside the same CHUNK_SIZE block
+ * The block starts with the change version of each column, so the header grows with the archetype, not MAX_COMPONENTS
+ * Unit of iteration for systems
+ * Remembers the version of the last write to each column, so readers can skip unchanged chunks
+ * Every entity of a chunk has the same shared component values
+ * Keeps an enabled bit per row after the change versions, disabled rows stay in place and are skipped a word at a time
+ * Columns of components deriving from ISoAComponent hold one array per field, each GetCapacity() fields long
+ * The entity of a row is read from the archetype's entity column, components don't store it
+ *
+ * Usage:
+ * for (Chunk& chunk : archetype->GetChunks())
+ * {
+ *     SoAArrays<Transform> transforms{ chunk.GetComponentArray<Transform>() };
+ *     for (size_t i{}; i < chunk.GetEntityCount(); ++i) ...
+ * }
+ * if (chunk.HasChanged<Transform>(lastVersion)) ...
+ * EntityId const* entityIds{ chunk.GetEntityIds() };
+ * chunk.ForEachEnabledRange([&](size_t begin, size_t end) { for (size_t i{ begin }; i < end; ++i) ... });
+ *
+ * Dependencies:
+ * Include Archetype.hpp to use GetComponentArray.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef CHUNK_HPP
+#define CHUNK_HPP
+
+#include <cstddef>
+#include "Alias.hpp"
+#include "Managers/ComponentManager.hpp"
+
+/**
+ * @brief Where a component type lives inside every chunk of an archetype
+ */
+struct ChunkColumn
+{
+	ComponentInfo const* info{ nullptr };
+	size_t offset{ 0 };
+};
+
+class Chunk
+{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param[in] archetype Archetype that owns the chunk
+		 * @param[in] columns Column layout of the archetype
+		 * @param[in] columnCount Number of columns of the archetype
+		 * @param[in] capacity Number of entities the chunk can hold
+		 * @param[in] firstRow Row of the chunk's first entity in the archetype
+		 * @param[in] data Memory from ChunkManager, starting with a header of GetHeaderSize(columnCount, capacity) bytes
+		 */
+		Chunk(Archetype* archetype, ChunkColumn const* columns, size_t columnCount, size_t capacity, size_t firstRow, std::byte* data);
+
+		/**
+		 * @brief Get the bytes at the start of a chunk used by the change versions and the enabled bits
+		 * @param[in] columnCount Number of columns of the archetype
+		 * @param[in] capacity Number of entities the chunk can hold
+		 */
+		static size_t GetHeaderSize(size_t columnCount, size_t capacity);
+
+		/**
+		 * @brief Get the archetype that owns the chunk
+		 */
+		Archetype* GetArchetype() const;
+
+		/**
+		 * @brief Get the number of entities stored in the chunk
+		 */
+		size_t GetEntityCount() const;
+
+		/**
+		 * @brief Get the number of entities the chunk can hold
+		 */
+		size_t GetCapacity() const;
+
+		/**
+		 * @brief Get the entity of every row of the chunk, entity i owns the components at index i of the arrays
+		 * @return Pointer to the entity of the first row, valid for GetEntityCount() entities
+		 */
+		EntityId const* GetEntityIds() const;
+
+		/**
+		 * @brief Get the component array of type T in this chunk. Valid for GetEntityCount() components.
+		 * @return Pointer to the first component of the array, or the field arrays of a component deriving from ISoAComponent
+		 */
+		template <typename T>
+		ComponentArray<T> GetComponentArray();
+
+		/**
+		 * @brief Get the component array of type T in a known column
+		 * @param[in] column Index of the column, from Archetype::GetColumnIndex
+		 */
+		template <typename T>
+		ComponentArray<T> GetComponentArray(size_t column);
+
+		/**
+		 * @brief Get the value of a shared component, the same for every entity of the chunk
+		 * @return Pointer to the value, or nullptr if the chunk's archetype doesn't have the shared component
+		 */
+		template <typename T>
+		T const* GetSharedComponent() const;
+
+		/**
+		 * @brief Get the address of a component. The component may not be constructed yet.
+		 * @param[in] index Index of the entity in the chunk
+		 * @param[in] column Index of the column in the archetype
+		 */
+		void* GetComponentAddress(size_t index, size_t column);
+
+		/**
+		 * @brief Get the bytes between two fields of the same component, for columns stored field by field
+		 * @param[in] column Index of the column in the archetype
+		 * @return Stride of the field arrays, 0 if the column stores whole components
+		 */
+		size_t GetFieldStride(size_t column) const;
+
+		/**
+		 * @brief Get the version of the last write to a column
+		 * @param[in] column Index of the column in the archetype
+		 */
+		ChangeVersion GetChangeVersion(size_t column) const;
+
+		/**
+		 * @brief Check if the T column was written after a version
+		 * @param[in] version Version to compare with, usually the reader's version of its last run
+		 */
+		template <typename T>
+		bool HasChanged(ChangeVersion version) const;
+
+		/**
+		 * @brief Stamp a column as written
+		 * @param[in] column Index of the column in the archetype
+		 * @param[in] version Version of the writer, from ArchetypeManager::GetVersion
+		 */
+		void MarkChanged(size_t column, ChangeVersion version);
+
+		/**
+		 * @brief Stamp the T column as written
+		 * @param[in] version Version of the writer, from ArchetypeManager::GetVersion
+		 */
+		template <typename T>
+		void MarkChanged(ChangeVersion version);
+
+		/**
+		 * @brief Stamp every column as written, for rows that were added, removed or moved
+		 * @param[in] version Version of the writer, from ArchetypeManager::GetVersion
+		 */
+		void MarkAllChanged(ChangeVersion version);
+
+		/**
+		 * @brief Check if an entity is enabled
+		 * @param[in] index Index of the entity in the chunk
+		 */
+		bool IsEnabled(size_t index) const;
+
+		/**
+		 * @brief Get the number of enabled entities in the chunk
+		 */
+		size_t GetEnabledCount() const;
+
+		/**
+		 * @brief Calls func(begin, end) for every run of enabled entities, in ascending order.
+		 * A chunk without disabled entities is a single call.
+		 * @param func Function called with the first index and one past the last index of the run
+		 */
+		template <typename Func>
+		void ForEachEnabledRange(Func&& func) const;
+
+	private:
+		friend class Archetype;
+
+		/**
+		 * @brief Enable or disable an entity. Use Archetype::SetEnabled, which also stamps the chunk.
+		 * @param[in] index Index of the entity in the chunk
+		 * @param[in] isEnabled New state of the entity
+		 */
+		void SetEnabled(size_t index, bool isEnabled);
+
+		/**
+		 * @brief Enable the bit of a row that was just added to the chunk
+		 * @param[in] index Index of the entity in the chunk
+		 */
+		void InsertRow(size_t index);
+
+		/**
+		 * @brief Clear the bit of the last row before it leaves the chunk, so runs never go past the entity count
+		 * @param[in] index Index of the entity in the chunk
+		 */
+		void EraseRow(size_t index);
+
+		/**
+		 * @brief Find the next entity with a given state, checking 64 entities per step
+		 * @param[in] index Index to start from
+		 * @param[in] isEnabled State to look for
+		 * @return Index of the entity, or GetEntityCount() if there is none
+		 */
+		size_t FindNext(size_t index, bool isEnabled) const;
+
+		Archetype* mArchetype;
+		ChunkColumn const* mColumns;
+		size_t mColumnCount;
+		size_t mCapacity;
+		size_t mFirstRow; // Row of the first entity in the archetype, a chunk always holds the same rows
+		std::byte* mData;
+		size_t mEntityCount;
+		ChangeVersion* mChangeVersions; // Version of the last write to each column, at the start of mData
+		uint64_t* mEnabledBits; // One bit per row after the change versions, rows past mEntityCount stay cleared
+		size_t mDisabledCount;
+};
+
+#endif // !CHUNK_HPP
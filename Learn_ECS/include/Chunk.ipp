@@ -0,0 +1,73 @@
+#include "Managers/ComponentManager.hpp"
+
+/**
+ * @brief Get the component array of type T in this chunk. Valid for GetEntityCount() components.
+ * @return Pointer to the first component of the array, or the field arrays of a component deriving from ISoAComponent
+ */
+template <typename T>
+ComponentArray<T> Chunk::GetComponentArray()
+{
+	return GetComponentArray<T>(mArchetype->GetColumnIndex(ComponentManager::GetComponentIndex<T>()));
+}
+
+/**
+ * @brief Get the component array of type T in a known column
+ * @param[in] column Index of the column, from Archetype::GetColumnIndex
+ */
+template <typename T>
+ComponentArray<T> Chunk::GetComponentArray(size_t column)
+{
+	return ComponentAccess<T>::MakeArray(GetComponentAddress(0, column), GetFieldStride(column));
+}
+
+/**
+ * @brief Get the value of a shared component, the same for every entity of the chunk
+ * @return Pointer to the value, or nullptr if the chunk's archetype doesn't have the shared component
+ */
+template <typename T>
+T const* Chunk::GetSharedComponent() const
+{
+	return mArchetype->GetSharedComponent<T>();
+}
+
+/**
+ * @brief Check if the T column was written after a version
+ * @param[in] version Version to compare with, usually the reader's version of its last run
+ */
+template <typename T>
+bool Chunk::HasChanged(ChangeVersion version) const
+{
+	return GetChangeVersion(mArchetype->GetColumnIndex(ComponentManager::GetComponentIndex<T>())) > version;
+}
+
+/**
+ * @brief Stamp the T column as written
+ * @param[in] version Version of the writer, from ArchetypeManager::GetVersion
+ */
+template <typename T>
+void Chunk::MarkChanged(ChangeVersion version)
+{
+	MarkChanged(mArchetype->GetColumnIndex(ComponentManager::GetComponentIndex<T>()), version);
+}
+
+/**
+ * @brief Calls func(begin, end) for every run of enabled entities, in ascending order.
+ * A chunk without disabled entities is a single call.
+ * @param func Function called with the first index and one past the last index of the run
+ */
+template <typename Func>
+void Chunk::ForEachEnabledRange(Func&& func) const
+{
+	if (mDisabledCount == 0)
+	{
+		if (mEntityCount > 0) func(size_t{ 0 }, mEntityCount);
+		return;
+	}
+
+	for (size_t begin{ FindNext(0, true) }; begin < mEntityCount;)
+	{
+		size_t end{ FindNext(begin, false) };
+		func(begin, end);
+		begin = FindNext(end, true);
+	}
+}
@@ -0,0 +1,175 @@
+/*************************************************************//**
+ * @file   CommandBuffer.hpp
+ * @brief  Records structural changes so they can be applied later, outside of iteration.
+ *
+ * Key features:
+ * Record spawn, destroy, add, remove, set and enable commands while iterating chunks
+ * Play the commands back at a sync point
+ * Spawns are applied per component set with EntityManager::CreateEntities
+ * Add/Remove are sorted by source archetype, destroys are applied from the last row of each archetype
+ *
+ * Usage:
+ * CommandBuffer& commandBuffer{ SystemManager::GetCommandBuffer() };
+ * commandBuffer.DestroyEntity(chunk.GetEntityIds()[i]); // inside a chunk loop
+ * commandBuffer.Playback();                             // after the loop, SystemManager does it after all systems
+ *
+ * Dependencies:
+ * Commands on entities that are destroyed before playback are skipped.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include "Alias.hpp"
+#include "Entity.hpp"
+
+class EntityManager;
+
+class CommandBuffer
+{
+	public:
+		/**
+		 * @brief Constructor
+		 */
+		CommandBuffer();
+		~CommandBuffer();
+
+		/**
+		 * @brief Commands own their component data, so the buffer can't be copied
+		 */
+		CommandBuffer(CommandBuffer const&) = delete;
+		CommandBuffer& operator=(CommandBuffer const&) = delete;
+
+		/**
+		 * @brief Record the creation of an entity with the given components
+		 * @param components rvalue references to the components
+		 */
+		template <typename... T>
+		void Spawn(T&&... components);
+
+		/**
+		 * @brief Record the destruction of an entity
+		 * @param entityId Entity member id
+		 */
+		void DestroyEntity(EntityId entityId);
+
+		/**
+		 * @brief Record adding a component to an entity
+		 * @param entityId Entity member id
+		 * @param component rvalue reference to a component
+		 */
+		template <typename T>
+		void AddComponent(EntityId entityId, T&& component);
+
+		/**
+		 * @brief Record removing a component from an entity
+		 * @param entityId Entity member id
+		 */
+		template <typename T>
+		void RemoveComponent(EntityId entityId);
+
+		/**
+		 * @brief Record setting the component data of an entity
+		 * @param entityId Entity member id
+		 * @param component rvalue reference to a component
+		 */
+		template <typename T>
+		void SetComponent(EntityId entityId, T&& component);
+
+		/**
+		 * @brief Record enabling or disabling an entity
+		 * @param entityId Entity member id
+		 * @param isEnabled New state of the entity
+		 */
+		void SetEnabled(EntityId entityId, bool isEnabled);
+
+		/**
+		 * @brief Apply every recorded command and clear the buffer.
+		 * Order: spawns, adds and removes, sets, enables, destroys.
+		 */
+		void Playback();
+
+		/**
+		 * @brief Check if there is any recorded command
+		 */
+		bool IsEmpty() const;
+
+	private:
+		/**
+		 * @brief Type-erased storage of the component data of every command on one component type
+		 */
+		struct IComponentCommands
+		{
+			virtual ~IComponentCommands() = default;
+			virtual void Add(EntityManager& em, Entity& entity, size_t payload) = 0;
+			virtual void Remove(EntityManager& em, Entity& entity) = 0;
+			virtual void Set(EntityManager& em, Entity& entity, size_t payload) = 0;
+			virtual void Clear() = 0;
+		};
+
+		template <typename T>
+		struct ComponentCommands : IComponentCommands
+		{
+			std::vector<T> payloads;
+			void Add(EntityManager& em, Entity& entity, size_t payload) override;
+			void Remove(EntityManager& em, Entity& entity) override;
+			void Set(EntityManager& em, Entity& entity, size_t payload) override;
+			void Clear() override;
+		};
+
+		/**
+		 * @brief Type-erased storage of every spawn with one set of components
+		 */
+		struct ISpawnCommands
+		{
+			virtual ~ISpawnCommands() = default;
+			virtual void Playback(EntityManager& em) = 0;
+			virtual bool IsEmpty() const = 0;
+		};
+
+		template <typename... T>
+		struct SpawnCommands : ISpawnCommands
+		{
+			std::vector<std::tuple<T...>> spawns;
+			void Playback(EntityManager& em) override;
+			bool IsEmpty() const override;
+		};
+
+		enum class CommandType { Add, Remove, Set };
+
+		struct Command
+		{
+			CommandType type;
+			EntityId entityId;
+			size_t componentIndex;
+			IComponentCommands* commands;
+			size_t payload;
+		};
+
+		/**
+		 * @brief Get the storage of the commands on component type T, creating it on first use
+		 */
+		template <typename T>
+		ComponentCommands<T>& GetComponentCommands();
+
+		std::unordered_map<std::type_index, std::unique_ptr<IComponentCommands>> mTypeToComponentCommandsMap;
+		std::unordered_map<std::type_index, std::unique_ptr<ISpawnCommands>> mTypeToSpawnCommandsMap;
+		std::vector<Command> mStructuralCommands; // Add and Remove
+		std::vector<Command> mSetCommands;
+		std::vector<std::pair<EntityId, bool>> mEnableCommands;
+		std::vector<EntityId> mDestroyedEntities;
+};
+
+#include "CommandBuffer.ipp"
+
+#endif // !COMMAND_BUFFER_HPP
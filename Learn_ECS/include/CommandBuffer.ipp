@@ -0,0 +1,112 @@
+#include <type_traits>
+#include "Managers/EntityManager.hpp"
+#include "Managers/ComponentManager.hpp"
+
+/**
+ * @brief Record the creation of an entity with the given components
+ * @param components rvalue references to the components
+ */
+template <typename... T>
+void CommandBuffer::Spawn(T&&... components)
+{
+	using Commands = SpawnCommands<std::decay_t<T>...>;
+	std::unique_ptr<ISpawnCommands>& commands{ mTypeToSpawnCommandsMap[std::type_index(typeid(Commands))] };
+	if (!commands) commands = std::make_unique<Commands>();
+	static_cast<Commands&>(*commands).spawns.emplace_back(std::forward<T>(components)...);
+}
+
+/**
+ * @brief Record adding a component to an entity
+ * @param entityId Entity member id
+ * @param component rvalue reference to a component
+ */
+template <typename T>
+void CommandBuffer::AddComponent(EntityId entityId, T&& component)
+{
+	using Component = std::decay_t<T>;
+	ComponentCommands<Component>& commands{ GetComponentCommands<Component>() };
+	size_t componentIndex{ ComponentManager::GetComponentIndex<Component>() };
+	mStructuralCommands.push_back(Command{ CommandType::Add, entityId, componentIndex, &commands, commands.payloads.size() });
+	commands.payloads.push_back(std::forward<T>(component));
+}
+
+/**
+ * @brief Record removing a component from an entity
+ * @param entityId Entity member id
+ */
+template <typename T>
+void CommandBuffer::RemoveComponent(EntityId entityId)
+{
+	ComponentCommands<T>& commands{ GetComponentCommands<T>() };
+	size_t componentIndex{ ComponentManager::GetComponentIndex<T>() };
+	mStructuralCommands.push_back(Command{ CommandType::Remove, entityId, componentIndex, &commands, 0 });
+}
+
+/**
+ * @brief Record setting the component data of an entity
+ * @param entityId Entity member id
+ * @param component rvalue reference to a component
+ */
+template <typename T>
+void CommandBuffer::SetComponent(EntityId entityId, T&& component)
+{
+	using Component = std::decay_t<T>;
+	ComponentCommands<Component>& commands{ GetComponentCommands<Component>() };
+	size_t componentIndex{ ComponentManager::GetComponentIndex<Component>() };
+	mSetCommands.push_back(Command{ CommandType::Set, entityId, componentIndex, &commands, commands.payloads.size() });
+	commands.payloads.push_back(std::forward<T>(component));
+}
+
+/**
+ * @brief Get the storage of the commands on component type T, creating it on first use
+ */
+template <typename T>
+CommandBuffer::ComponentCommands<T>& CommandBuffer::GetComponentCommands()
+{
+	std::unique_ptr<IComponentCommands>& commands{ mTypeToComponentCommandsMap[std::type_index(typeid(T))] };
+	if (!commands) commands = std::make_unique<ComponentCommands<T>>();
+	return static_cast<ComponentCommands<T>&>(*commands);
+}
+
+template <typename T>
+void CommandBuffer::ComponentCommands<T>::Add(EntityManager& em, Entity& entity, size_t payload)
+{
+	em.AddComponent<T>(entity, std::move(payloads[payload]));
+}
+
+template <typename T>
+void CommandBuffer::ComponentCommands<T>::Remove(EntityManager& em, Entity& entity)
+{
+	em.RemoveComponent<T>(entity);
+}
+
+template <typename T>
+void CommandBuffer::ComponentCommands<T>::Set(EntityManager& em, Entity& entity, size_t payload)
+{
+	em.SetComponent<T>(entity, std::move(payloads[payload]));
+}
+
+template <typename T>
+void CommandBuffer::ComponentCommands<T>::Clear()
+{
+	payloads.clear();
+}
+
+/**
+ * @brief Spawn everything in one burst, the archetype is resolved once
+ */
+template <typename... T>
+void CommandBuffer::SpawnCommands<T...>::Playback(EntityManager& em)
+{
+	em.CreateEntities<T...>(spawns.size(), [this](size_t i)
+	{
+		return std::move(spawns[i]);
+	});
+	spawns.clear();
+}
+
+template <typename... T>
+bool CommandBuffer::SpawnCommands<T...>::IsEmpty() const
+{
+	return spawns.empty();
+}
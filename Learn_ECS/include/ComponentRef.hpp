@@ -0,0 +1,80 @@
+/*************************************************************//**
+ * @file   ComponentRef.hpp
+ * @brief  Reference to the component of an entity that survives the entity moving between archetypes.
+ *
+ * Key features:
+ * Stores the entity id and a cached pointer into the entity's chunk
+ * Revalidates with a single compare against ArchetypeManager's structure version
+ * Looks the entity up again after a structural change, no registry of references to update
+ * Returns nullptr once the entity is destroyed or loses the component
+ * ComponentRef<T const> doesn't mark the column as changed
+ * Components stored field by field are reached through a SoAPointer, used the same way
+ *
+ * Usage:
+ * ComponentRef<Transform> transform{ GetComponent<Transform>() };
+ * if (transform) transform->x += 1.f;
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef COMPONENT_REF_HPP
+#define COMPONENT_REF_HPP
+
+#include <cstdint>
+#include "Alias.hpp"
+#include "Managers/ComponentManager.hpp"
+
+class Chunk;
+
+template <typename T>
+class ComponentRef
+{
+	public:
+		/**
+		 * @brief Constructor. References nothing.
+		 */
+		ComponentRef() = default;
+
+		/**
+		 * @brief Constructor
+		 * @param[in] entityId Entity that owns the component
+		 */
+		explicit ComponentRef(EntityId entityId);
+
+		/**
+		 * @brief Get the component, and mark its column as changed unless T is const
+		 * @return Pointer to the component, or nullptr if the entity is destroyed or doesn't have it
+		 */
+		ComponentPointer<T> Get() const;
+
+		/**
+		 * @brief Get the entity that owns the component
+		 */
+		EntityId GetEntityId() const;
+
+		ComponentPointer<T> operator->() const;
+		ComponentReference<T> operator*() const;
+		explicit operator bool() const;
+
+	private:
+		/**
+		 * @brief Look the entity up again and cache where its component lives
+		 */
+		void Resolve() const;
+
+		EntityId mEntityId{ INVALID_ENTITY_ID };
+
+		// Cache, valid while mStructureVersion matches ArchetypeManager's. Structure versions start at 1.
+		mutable uint32_t mStructureVersion{ 0 };
+		mutable Chunk* mChunk{ nullptr };
+		mutable size_t mColumn{ 0 };
+		mutable ComponentPointer<T> mComponent{ nullptr };
+};
+
+#include "ComponentRef.ipp"
+
+#endif // !COMPONENT_REF_HPP
@@ -0,0 +1,87 @@
+#include <type_traits>
+#include "Managers/ArchetypeManager.hpp"
+#include "Managers/EntityManager.hpp"
+#include "Archetype.hpp"
+
+/**
+ * @brief Constructor
+ * @param[in] entityId Entity that owns the component
+ */
+template <typename T>
+ComponentRef<T>::ComponentRef(EntityId entityId) :
+	mEntityId{ entityId }, mStructureVersion{ 0 }, mChunk{ nullptr }, mColumn{ 0 }, mComponent{ nullptr }
+{}
+
+/**
+ * @brief Get the component, and mark its column as changed unless T is const
+ * @return Pointer to the component, or nullptr if the entity is destroyed or doesn't have it
+ */
+template <typename T>
+ComponentPointer<T> ComponentRef<T>::Get() const
+{
+	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
+	if (mStructureVersion != am.GetStructureVersion())
+		Resolve();
+
+	if constexpr (!std::is_const_v<T>)
+	{
+		if (mChunk)
+			mChunk->MarkChanged(mColumn, am.GetVersion());
+	}
+	return mComponent;
+}
+
+/**
+ * @brief Get the entity that owns the component
+ */
+template <typename T>
+EntityId ComponentRef<T>::GetEntityId() const
+{
+	return mEntityId;
+}
+
+template <typename T>
+ComponentPointer<T> ComponentRef<T>::operator->() const
+{
+	return Get();
+}
+
+template <typename T>
+ComponentReference<T> ComponentRef<T>::operator*() const
+{
+	return *Get();
+}
+
+template <typename T>
+ComponentRef<T>::operator bool() const
+{
+	return static_cast<bool>(Get());
+}
+
+/**
+ * @brief Look the entity up again and cache where its component lives
+ */
+template <typename T>
+void ComponentRef<T>::Resolve() const
+{
+	static_assert(!IsSharedComponent<T>, "Shared components are read with EntityManager::GetSharedComponent.");
+	using Component = std::remove_const_t<T>;
+	mStructureVersion = ArchetypeManager::GetInstance().GetStructureVersion();
+	mChunk = nullptr;
+	mComponent = nullptr;
+
+	EntityManager& em{ EntityManager::GetInstance() };
+	if (!em.IsAlive(mEntityId)) return;
+	EntityRecord const& record{ em.GetRecord(mEntityId) };
+	Archetype* archetype{ record.archetype };
+	if (archetype == nullptr) return;
+
+	size_t column{ archetype->GetColumnIndex(ComponentManager::GetComponentIndex<Component>()) };
+	if (column == Archetype::INVALID_COLUMN) return;
+
+	size_t capacity{ archetype->GetChunkCapacity() };
+	Chunk& chunk{ archetype->GetChunks()[record.row / capacity] };
+	mComponent = ComponentAccess<T>::MakePointer(chunk.GetComponentAddress(record.row % capacity, column), chunk.GetFieldStride(column));
+	mChunk = &chunk;
+	mColumn = column;
+}
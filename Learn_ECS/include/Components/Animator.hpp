@@ -30,8 +30,7 @@
 
 #include <unordered_map>
 #include <string>
-
-#include "Interfaces/IComponent.hpp"
+#include <vector>
 
 struct Frame
 {
@@ -58,7 +57,7 @@ struct Animation
 		size_t GetFrameCount() const;
 };
 
-struct Animator : IComponent
+struct Animator
 {
 	public:
 		std::string currentAnimation{};
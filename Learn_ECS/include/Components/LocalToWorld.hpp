@@ -0,0 +1,30 @@
+/*************************************************************//**
+ * @file   LocalToWorld.hpp
+ * @brief  Component holding the world transform of an entity, computed by TransformSystem.
+ *
+ * Key features:
+ * Model-to-World matrix, with the entity's width and height, ready to be sent to the GPU
+ * World position and angle without the size, which children are placed relative to
+ *
+ * Usage:
+ * Add it next to Transform, TransformSystem fills it every frame.
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef LOCAL_TO_WORLD_HPP
+#define LOCAL_TO_WORLD_HPP
+
+#include <glm/glm.hpp>
+
+struct LocalToWorld
+{
+	glm::mat3 matrix{ 1.f };
+	float x{ 0.f }, y{ 0.f }, a{ 0.f }; // World position and angle
+};
+
+#endif // !LOCAL_TO_WORLD_HPP
@@ -17,12 +17,20 @@
 #ifndef MONO_BEHAVIOUR_HPP
 #define MONO_BEHAVIOUR_HPP
 
+#include <memory>
 #include "Interfaces/IComponent.hpp"
 
 struct MonoBehaviour : IComponent
 {
 	virtual void Start() = 0;
 	virtual void Update() = 0;
+
+	/**
+	 * @brief Copy the script, used when a prefab is instantiated
+	 * @return Copy of the most derived type
+	 */
+	virtual std::unique_ptr<MonoBehaviour> Clone() const = 0;
+
 	virtual ~MonoBehaviour() = default;
 };
 
@@ -0,0 +1,47 @@
+/*************************************************************//**
+ * @file   Parent.hpp
+ * @brief  Components linking an entity to its parent and its children.
+ *
+ * Key features:
+ * Parent is the entity the Transform is relative to
+ * Children lists the entities whose Parent is this entity
+ * HierarchyDepth groups entities by their distance to the root, so every level lives in its own chunks
+ *
+ * Usage:
+ * EntityManager::GetInstance().SetParent(weapon, player);
+ * EntityManager::GetInstance().RemoveParent(weapon);
+ *
+ * Dependencies:
+ * Don't add these components directly, SetParent and RemoveParent keep them consistent.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef PARENT_HPP
+#define PARENT_HPP
+
+#include <vector>
+#include "Alias.hpp"
+#include "Interfaces/ISharedComponent.hpp"
+
+struct Parent
+{
+	EntityId parentId{ INVALID_ENTITY_ID };
+};
+
+struct Children
+{
+	std::vector<EntityId> childIds{};
+};
+
+// Roots don't have the component, their depth is 0
+struct HierarchyDepth : ISharedComponent
+{
+	uint32_t depth{ 0 };
+
+	bool operator==(HierarchyDepth const& rhs) const { return depth == rhs.depth; }
+};
+
+#endif // !PARENT_HPP
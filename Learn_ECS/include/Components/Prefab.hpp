@@ -0,0 +1,29 @@
+/*************************************************************//**
+ * @file   Prefab.hpp
+ * @brief  Tag of entities that are templates for other entities.
+ *
+ * Key features:
+ * Prefabs are built once like any entity, then copied with EntityManager::Instantiate
+ * Queries skip archetypes with the tag, so systems never update or draw a prefab
+ * Copies don't have the tag
+ *
+ * Usage:
+ * Entity& prefab{ entityManager.CreatePrefab() };
+ * entityManager.AddComponent<Transform>(prefab, Transform{ ... });
+ * entityManager.Instantiate(prefab, 100);
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef PREFAB_HPP
+#define PREFAB_HPP
+
+struct Prefab
+{
+};
+
+#endif // !PREFAB_HPP
@@ -17,9 +17,7 @@
 #ifndef RIGIDBODY_2D_HPP
 #define RIGIDBODY_2D_HPP
 
-#include "Interfaces/IComponent.hpp"
-
-struct Rigidbody2D : IComponent
+struct Rigidbody2D
 {
 	float vx, vy; // TODO use 2D vector instead of floats
 	Rigidbody2D(float _x, float _y);
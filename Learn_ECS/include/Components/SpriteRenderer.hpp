@@ -19,19 +19,16 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include "Components/Texture.hpp"
-#include "Interfaces/IComponent.hpp"
 #include "Alias.hpp"
 
-struct SpriteRenderer : public IComponent
+// The sprite sheet is the entity's Texture shared component
+struct SpriteRenderer
 {
-	Texture sprite;
-	GLint cellWidth;
-	GLint cellHeight;
+	GLint cellWidth{ 0 };  // 0 uses the width of the texture
+	GLint cellHeight{ 0 }; // 0 uses the height of the texture
 	GLint row{ 0 }, col{ 0 };
 	bool flipX{ false };
 	bool flipY{ false };
-
-	SpriteRenderer(Texture _sprite);
 };
 
 #endif // !SPRITE_RENDERER_HPP
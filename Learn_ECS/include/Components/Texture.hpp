@@ -1,11 +1,11 @@
 /*************************************************************//**
  * @file   Texture.hpp
- * @brief  Definition of the Texture. Not really a component,
- * just a supporting struct for SpriteRenderer component
+ * @brief  Definition of the Texture. Shared component of the entities drawn with a SpriteRenderer.
  *
  * Key features:
  * Stores texture information. Its ID, width, and height.
  * Width and height is used to calculate UVs.
+ * Shared, so entities with the same texture are grouped in the same chunks.
  *
  * Usage:
  *
@@ -20,12 +20,21 @@
 #define TEXTURE_HPP
 
 #include "Alias.hpp"
+#include "Interfaces/ISharedComponent.hpp"
 
-struct Texture
+struct Texture : ISharedComponent
 {
-	TextureId mId;
-	GLint mTextureWidth;
-	GLint mTextureHeight;
+	TextureId mId{ 0 };
+	GLint mTextureWidth{ 0 };
+	GLint mTextureHeight{ 0 };
+
+	Texture() = default;
+	Texture(TextureId id, GLint width, GLint height);
+
+	/**
+	 * @brief Textures are the same if they have the same ID
+	 */
+	bool operator==(Texture const& rhs) const;
 };
 
 #endif // !TEXTURE_HPP
@@ -7,10 +7,13 @@
  * Rotation (a)
  * Width    (w)
  * Height   (h)
+ * Stored one array per field, see ISoAComponent
  *
  * Usage:
+ * Transform is the value, SoARef<Transform> the fields of an entity and SoAArrays<Transform> the fields of a chunk
  *
  * Dependencies:
+ * ISoAComponent
  *
  * @author HONG Xian Xiang
  * @date   3rd October 2024
@@ -20,12 +23,17 @@
 #ifndef TRANSFORM_HPP
 #define TRANSFORM_HPP
 
-#include "Interfaces/IComponent.hpp"
+#include "Interfaces/ISoAComponent.hpp"
 
-struct Transform : IComponent
+template <typename F>
+struct TransformFields : ISoAComponent
 {
-	float x, y, a, w, h;
-	Transform(float _x, float _y, float _a, float _w, float _h);
+	F x, y, a, w, h;
+	TransformFields(F _x, F _y, F _a, F _w, F _h) :
+		x{ _x }, y{ _y }, a{ _a }, w{ _w }, h{ _h }
+	{}
 };
 
+using Transform = TransformFields<float>;
+
 #endif // !TRANSFORM_HPP
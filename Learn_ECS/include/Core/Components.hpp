@@ -6,6 +6,9 @@
 #include "Components/SpriteRenderer.hpp"
 #include "Components/Animator.hpp"
 #include "Components/MonoBehaviour.hpp"
+#include "Components/Prefab.hpp"
+#include "Components/Parent.hpp"
+#include "Components/LocalToWorld.hpp"
 #include "Interfaces/IComponent.ipp"
 
 #endif // !COMPONENTS_HPP
@@ -19,6 +19,39 @@
 
 #include "Alias.hpp"
 
+/**
+ * @brief Where an entity lives. Kept by EntityManager next to the entity.
+ */
+struct EntityRecord
+{
+	Archetype* archetype{ nullptr };
+	size_t row{ 0 }; // Row of the entity in its archetype
+};
+
+/**
+ * @brief Get the index part of an entity id, which is reused after the entity is destroyed
+ */
+constexpr size_t GetEntityIndex(EntityId id)
+{
+	return id & ((1u << ENTITY_INDEX_BITS) - 1);
+}
+
+/**
+ * @brief Get the generation part of an entity id, which is bumped every time the index is reused
+ */
+constexpr uint32_t GetEntityGeneration(EntityId id)
+{
+	return id >> ENTITY_INDEX_BITS;
+}
+
+/**
+ * @brief Combine an index and a generation into an entity id. The generation wraps around.
+ */
+constexpr EntityId MakeEntityId(size_t index, uint32_t generation)
+{
+	return static_cast<EntityId>(generation << ENTITY_INDEX_BITS) | static_cast<EntityId>(index);
+}
+
 class Entity
 {
 	public:
@@ -26,7 +59,7 @@ class Entity
 		 * @brief Constructor
 		 * @param id Entity member id
 		 */
-		Entity(EntityId id);
+		Entity(EntityId id = INVALID_ENTITY_ID);
 
 		/**
 		 * @brief Get entity's archetype signature
@@ -7,7 +7,8 @@
  * Stores the entity's ID to know which component to get.
  *
  * Usage:
- * Used in MonoBehaviours.
+ * Used in MonoBehaviours. Data components are plain structs without it, so they stay small and trivially copyable.
+ * The entity of a row can be read from Chunk::GetEntityIds instead.
  *
  * Dependencies:
  *
@@ -21,18 +22,20 @@
 
 #include "Alias.hpp"
 
+template <typename T>
+class ComponentRef;
+
 struct IComponent
 {
 	// Initialize to max value because compiler can't stop complaining
-	EntityId entityId{ static_cast<EntityId>(-1) };
+	EntityId entityId{ INVALID_ENTITY_ID };
 
 	/**
-	 * @brief Gets a component of an entity;
-	 * @param[in,out] handle Handle to the component.
-	 * @return Pointer to the component.
+	 * @brief Gets a component of the entity. Keep the reference instead of the pointer it returns.
+	 * @return Reference to the component, stays valid when the entity changes archetype.
 	 */
 	template <typename T>
-	T* GetComponent(T** handle);
+	ComponentRef<T> GetComponent() const;
 
 	virtual ~IComponent() noexcept = default;
 };
@@ -14,17 +14,15 @@
  * Copyright 2024, Digipen Institute of Technology
 *****************************************************************/
 
-#include "Managers/EntityManager.hpp"
 #include "Interfaces/IComponent.hpp"
+#include "ComponentRef.hpp"
 
 /**
- * @brief Gets a component of an entity;
- * @param[in,out] handle Handle to the component.
- * @return Pointer to the component.
+ * @brief Gets a component of the entity. Keep the reference instead of the pointer it returns.
+ * @return Reference to the component, stays valid when the entity changes archetype.
  */
 template <typename T>
-T* IComponent::GetComponent(T** handle)
+ComponentRef<T> IComponent::GetComponent() const
 {
-	EntityManager& em{ EntityManager::GetInstance() };
-	return em.GetComponent(em.GetEntity(entityId), handle);
+	return ComponentRef<T>{ entityId };
 }
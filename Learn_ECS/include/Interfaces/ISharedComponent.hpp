@@ -0,0 +1,28 @@
+/*************************************************************//**
+ * @file   ISharedComponent.hpp
+ * @brief  Base class of shared components. Their value is stored once per archetype instead of per entity.
+ *
+ * Key features:
+ * Entities with the same shared value are grouped in the same archetype, so in the same chunks
+ * Read per chunk with Chunk::GetSharedComponent, not through a query's arrays
+ *
+ * Usage:
+ * struct Texture : ISharedComponent { ... bool operator==(Texture const& rhs) const; };
+ * EntityManager::GetInstance().SetSharedComponent(entity, texture);
+ *
+ * Dependencies:
+ * Shared components need an operator==, values are compared to find their archetype.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef I_SHARED_COMPONENT_HPP
+#define I_SHARED_COMPONENT_HPP
+
+struct ISharedComponent
+{
+};
+
+#endif // !I_SHARED_COMPONENT_HPP
@@ -0,0 +1,137 @@
+/*************************************************************//**
+ * @file   ISoAComponent.hpp
+ * @brief  Base class of components stored field by field. Chunks keep one array per field
+ * instead of one array of structs.
+ *
+ * Key features:
+ * A loop that only touches some fields only loads those fields, and each field array can be loaded 8 floats at a time
+ * The component is a template over the type of its fields, which gives the value, the reference and the arrays from one definition
+ * Queries pass SoAArrays<T> per chunk and SoARef<T> per entity, GetComponent returns a SoAPointer<T>
+ *
+ * Usage:
+ * template <typename F>
+ * struct PositionFields : ISoAComponent { F x, y; PositionFields(F _x, F _y) : x{ _x }, y{ _y } {} };
+ * using Position = PositionFields<float>;
+ *
+ * query.ForEachChunk([](Chunk& chunk, SoAArrays<Position> pv) { ... pv.y[i] -= 1.f; ... });
+ * query.ForEach([](SoARef<Position> position) { position.y -= 1.f; });
+ * entityManager.GetComponent<Position>(entity)->x = 5.f;
+ *
+ * Dependencies:
+ * Every field has the same trivially copyable type, they are moved with memcpy.
+ * The template needs a constructor taking every field in order, it is used to build the references and arrays.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef I_SOA_COMPONENT_HPP
+#define I_SOA_COMPONENT_HPP
+
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+struct ISoAComponent
+{
+};
+
+/**
+ * @brief Component stored field by field, see ISoAComponent
+ */
+template <typename T>
+inline constexpr bool IsSoAComponent{ std::is_base_of_v<ISoAComponent, std::remove_cv_t<T>> };
+
+/**
+ * @brief Field layout of a component stored field by field. Field k of a row is stride bytes after field k - 1.
+ */
+template <typename T>
+struct SoALayout;
+
+template <template <typename> class C, typename F>
+struct SoALayout<C<F>>
+{
+	static_assert(std::is_trivially_copyable_v<C<F>> && std::is_standard_layout_v<C<F>>, "Fields are moved with memcpy.");
+	static_assert(sizeof(C<F>) % sizeof(F) == 0, "Every field of a component stored field by field has the same type.");
+
+	using Field = F;
+	using Ref = C<F&>;
+	using ConstRef = C<F const&>;
+	using Arrays = C<F*>;
+	using ConstArrays = C<F const*>;
+	static constexpr size_t fieldCount{ sizeof(C<F>) / sizeof(F) };
+
+	/**
+	 * @brief Get the field arrays of a column
+	 * @param address Address of the first field of the first row
+	 * @param stride Bytes between two fields of the same row
+	 */
+	static Arrays MakeArrays(void* address, size_t stride);
+	static ConstArrays MakeArrays(void const* address, size_t stride);
+
+	/**
+	 * @brief Get the fields of a row from the arrays of its column
+	 */
+	static Ref MakeRef(Arrays const& arrays, size_t index);
+	static ConstRef MakeRef(ConstArrays const& arrays, size_t index);
+
+	private:
+		template <typename A, typename P, size_t... I>
+		static A MakeArrays(P* address, size_t stride, std::index_sequence<I...>);
+
+		template <typename R, typename A, size_t... I>
+		static R MakeRef(A const& arrays, size_t index, std::index_sequence<I...>);
+};
+
+/**
+ * @brief Fields of one entity, as references. Const components give const references.
+ */
+template <typename T>
+using SoARef = std::conditional_t<std::is_const_v<T>,
+	typename SoALayout<std::remove_const_t<T>>::ConstRef, typename SoALayout<std::remove_const_t<T>>::Ref>;
+
+/**
+ * @brief Field arrays of a chunk. Const components give const arrays.
+ */
+template <typename T>
+using SoAArrays = std::conditional_t<std::is_const_v<T>,
+	typename SoALayout<std::remove_const_t<T>>::ConstArrays, typename SoALayout<std::remove_const_t<T>>::Arrays>;
+
+/**
+ * @brief What GetComponent returns for a component stored field by field, behaves like a pointer to SoARef<T>
+ */
+template <typename T>
+class SoAPointer
+{
+	public:
+		/**
+		 * @brief Constructor. Points to nothing.
+		 */
+		SoAPointer() = default;
+		SoAPointer(std::nullptr_t);
+
+		/**
+		 * @brief Constructor
+		 * @param ref Fields of the component
+		 */
+		SoAPointer(SoARef<T> const& ref);
+
+		SoAPointer(SoAPointer const& rhs);
+		SoAPointer& operator=(SoAPointer const& rhs);
+
+		/**
+		 * @brief The fields are references, writing through a const SoARef still writes the component
+		 */
+		SoARef<T> const* operator->() const;
+		SoARef<T> const& operator*() const;
+		explicit operator bool() const;
+
+	private:
+		std::optional<SoARef<T>> mRef;
+};
+
+#include "Interfaces/ISoAComponent.ipp"
+
+#endif // !I_SOA_COMPONENT_HPP
@@ -0,0 +1,100 @@
+#include <array>
+#include <cstring>
+
+/**
+ * @brief Get the field arrays of a column
+ * @param address Address of the first field of the first row
+ * @param stride Bytes between two fields of the same row
+ */
+template <template <typename> class C, typename F>
+typename SoALayout<C<F>>::Arrays SoALayout<C<F>>::MakeArrays(void* address, size_t stride)
+{
+	return MakeArrays<Arrays>(static_cast<std::byte*>(address), stride, std::make_index_sequence<fieldCount>{});
+}
+
+template <template <typename> class C, typename F>
+typename SoALayout<C<F>>::ConstArrays SoALayout<C<F>>::MakeArrays(void const* address, size_t stride)
+{
+	return MakeArrays<ConstArrays>(static_cast<std::byte const*>(address), stride, std::make_index_sequence<fieldCount>{});
+}
+
+/**
+ * @brief Get the fields of a row from the arrays of its column
+ */
+template <template <typename> class C, typename F>
+typename SoALayout<C<F>>::Ref SoALayout<C<F>>::MakeRef(Arrays const& arrays, size_t index)
+{
+	return MakeRef<Ref>(arrays, index, std::make_index_sequence<fieldCount>{});
+}
+
+template <template <typename> class C, typename F>
+typename SoALayout<C<F>>::ConstRef SoALayout<C<F>>::MakeRef(ConstArrays const& arrays, size_t index)
+{
+	return MakeRef<ConstRef>(arrays, index, std::make_index_sequence<fieldCount>{});
+}
+
+template <template <typename> class C, typename F>
+template <typename A, typename P, size_t... I>
+A SoALayout<C<F>>::MakeArrays(P* address, size_t stride, std::index_sequence<I...>)
+{
+	using Pointer = std::conditional_t<std::is_const_v<P>, F const*, F*>;
+	return A{ reinterpret_cast<Pointer>(address + I * stride)... };
+}
+
+template <template <typename> class C, typename F>
+template <typename R, typename A, size_t... I>
+R SoALayout<C<F>>::MakeRef(A const& arrays, size_t index, std::index_sequence<I...>)
+{
+	// Arrays only hold the field pointers, in order
+	using Pointer = std::conditional_t<std::is_same_v<A, ConstArrays>, F const*, F*>;
+	static_assert(sizeof(A) == sizeof(Pointer) * fieldCount, "Arrays have one pointer per field.");
+	std::array<Pointer, fieldCount> pointers;
+	std::memcpy(pointers.data(), &arrays, sizeof(A));
+	return R{ pointers[I][index]... };
+}
+
+template <typename T>
+SoAPointer<T>::SoAPointer(std::nullptr_t)
+{}
+
+/**
+ * @brief Constructor
+ * @param ref Fields of the component
+ */
+template <typename T>
+SoAPointer<T>::SoAPointer(SoARef<T> const& ref) :
+	mRef{ ref }
+{}
+
+template <typename T>
+SoAPointer<T>::SoAPointer(SoAPointer const& rhs) :
+	mRef{ rhs.mRef }
+{}
+
+template <typename T>
+SoAPointer<T>& SoAPointer<T>::operator=(SoAPointer const& rhs)
+{
+	// References can't be rebound, so rebuild the fields
+	mRef.reset();
+	if (rhs.mRef)
+		mRef.emplace(*rhs.mRef);
+	return *this;
+}
+
+template <typename T>
+SoARef<T> const* SoAPointer<T>::operator->() const
+{
+	return &*mRef;
+}
+
+template <typename T>
+SoARef<T> const& SoAPointer<T>::operator*() const
+{
+	return *mRef;
+}
+
+template <typename T>
+SoAPointer<T>::operator bool() const
+{
+	return mRef.has_value();
+}
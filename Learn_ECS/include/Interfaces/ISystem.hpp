@@ -3,6 +3,7 @@
  * @brief  Base class ISystem, acts as an interface
  *
  * Key features:
+ * Systems declare the components they read and write so SystemManager can run them in parallel
  *
  * Usage:
  *
@@ -16,12 +17,32 @@
 #ifndef I_SYSTEM_HPP
 #define I_SYSTEM_HPP
 
+#include "Alias.hpp"
+
+/**
+ * @brief Components a system touches during Update
+ */
+struct SystemAccess
+{
+	Signature reads{ 0 };
+	Signature writes{ 0 };
+
+	// Conflicts with every other system, for systems that can touch anything like scripts
+	bool isExclusive{ true };
+};
+
 class ISystem
 {
 	public:
 		virtual void Init() = 0;
 		virtual void Update() = 0;
 		virtual ~ISystem() noexcept = default;
+
+		/**
+		 * @brief Get the components the system reads and writes during Update.
+		 * Systems that don't override it are exclusive and never run alongside another system.
+		 */
+		virtual SystemAccess GetAccess() const { return SystemAccess{}; }
 };
 
 #endif // !I_SYSTEM_HPP
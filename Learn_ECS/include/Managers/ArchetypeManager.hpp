@@ -5,14 +5,20 @@
  * Key features:
  * Is a Singleton
  * Create Archetypes
- * Destroy Archetypes
- * Get Archetypes
+ * Destroy Archetypes, empty ones are kept until a budgeted collection pass
+ * Get Archetypes, identified by their signature and the values of their shared components
+ * Move entities between archetypes when a shared component value changes
  * Add Entities to Archetypes
  * Remove Entities from Archetypes
  * Add components to Entity
  * Remove components from Entity
+ * Move an entity straight to the archetype of a new signature, for adding or removing several components at once
  * Copy components from Archetype to Archetype
  * Get Archetype Set (Archetypes that have common signatures)
+ * Link and follow the add/remove component edges between Archetypes
+ * Get Queries, kept matched with the Archetypes as they are created and destroyed
+ * Keep the version that chunk columns are stamped with when written
+ * Count structural changes, so ComponentRefs know when their cached pointer may be stale
  *
  * Usage:
  *
@@ -28,11 +34,28 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
+#include <array>
+#include <atomic>
+#include <typeindex>
 #include "Archetype.hpp"
+#include "Query.hpp"
 #include "Entity.hpp"
 
+/**
+ * @brief Archetype counters, to tune how often and how much CollectEmptyArchetypes reclaims
+ */
+struct ArchetypeStats
+{
+	size_t archetypeCount{ 0 };      // Archetypes alive, empty ones included
+	size_t emptyArchetypeCount{ 0 }; // Archetypes without entities, kept for reuse
+	size_t createdCount{ 0 };        // Archetypes created since the start
+	size_t destroyedCount{ 0 };      // Archetypes reclaimed since the start
+	size_t lastCollectedCount{ 0 };  // Archetypes reclaimed by the last CollectEmptyArchetypes
+};
+
 class ArchetypeManager
 {
 	public:
@@ -50,43 +73,102 @@ class ArchetypeManager
 		/**
 		 * @brief Creates an archetype with a given signature. Doesn't do anything if archetype exists
 		 * @param signature Signature of the Archetype to create
+		 * @param sharedValues Values of the shared components in the signature, sorted by component index
 		 * @return Pointer to the created archetype, or nullptr.
 		 */
-		Archetype* CreateArchetype(Signature signature);
+		Archetype* CreateArchetype(Signature signature, SharedValues const& sharedValues = {});
 
 		/**
 		 * @brief Get a shared pointer to desired archetype.
 		 * @param signature Signature of the Archetype to get
+		 * @param sharedValues Values of the shared components in the signature, sorted by component index
 		 * @return Pointer to the created archetype, or nullptr.
 		 */
-		Archetype* GetArchetype(Signature signature);
+		Archetype* GetArchetype(Signature signature, SharedValues const& sharedValues = {});
 
 		/**
 		 * @brief Destroy an archetype
 		 * @param signature Signature of the Archetype
+		 * @param sharedValues Values of the shared components in the signature, sorted by component index
+		 */
+		void DestroyArchetype(Signature signature, SharedValues const& sharedValues = {});
+
+		/**
+		 * @brief Destroy archetypes that were already empty on the previous pass, so that archetypes
+		 * emptied and refilled between two passes are kept. Call it every few seconds, not every frame.
+		 * @param budget Maximum number of archetypes to destroy, the rest waits for the next pass
+		 * @return Number of archetypes destroyed
+		 */
+		size_t CollectEmptyArchetypes(size_t budget);
+
+		/**
+		 * @brief Get the archetype counters
+		 */
+		ArchetypeStats GetStats() const;
+
+		/**
+		 * @brief Get the edge for adding a component, creating the archetype it leads to on first use.
+		 * @param from Archetype of the entity, or nullptr if the entity has no components
+		 * @param componentIndex Index of the component to add
+		 * @return Reference to the edge, owned by "from"
 		 */
-		void DestroyArchetype(Signature signature);
+		ArchetypeEdge& GetAddEdge(Archetype* from, size_t componentIndex);
+
+		/**
+		 * @brief Get the edge for removing a component, creating the archetype it leads to on first use.
+		 * @param from Archetype of the entity
+		 * @param componentIndex Index of the component to remove
+		 * @return Reference to the edge, owned by "from"
+		 */
+		ArchetypeEdge& GetRemoveEdge(Archetype* from, size_t componentIndex);
 
 		/**
 		 * @brief Add component data to an entity. This operation will move the entity to a new archetype.
-		 * @param entity Reference to an entity
+		 * @param entityId Entity member id
+		 * @param record Record of the entity, updated to the new archetype and row
+		 * @param edge Add edge of the component, from GetAddEdge
 		 * @param component rvalue reference to component
+		 * @return Pointer to the archetype the entity was moved to
 		 */
 		template <typename T>
-		void AddComponent(Archetype* archetype, T&& component, Entity const& entity);
+		Archetype* AddComponent(EntityId entityId, EntityRecord& record, ArchetypeEdge const& edge, T&& component);
 
 		/**
 		 * @brief Remove component data from an entity. This operation will move the entity to a new archetype.
-		 * @param entity Reference to an entity
+		 * @param entityId Entity member id
+		 * @param record Record of the entity, updated to the new archetype and row
+		 * @param edge Remove edge of the component, from GetRemoveEdge
+		 * @return Pointer to the archetype the entity was moved to
 		 */
-		template <typename T>
-		void RemoveComponent(Archetype* archetype, Entity const& entity);
+		Archetype* RemoveComponent(EntityId entityId, EntityRecord& record, ArchetypeEdge const& edge);
+
+		/**
+		 * @brief Add a shared component to an entity or change its value. This operation will move the entity
+		 * to the archetype of the new value. Values change rarely, so the move isn't cached on an edge.
+		 * @param entityId Entity member id
+		 * @param record Record of the entity, updated to the new archetype and row
+		 * @param componentIndex Index of the shared component
+		 * @param valueIndex Index of the value, from SharedComponentManager::AddValue
+		 * @return Pointer to the archetype the entity was moved to
+		 */
+		Archetype* SetSharedComponent(EntityId entityId, EntityRecord& record, size_t componentIndex, uint32_t valueIndex);
+
+		/**
+		 * @brief Move an entity straight to the archetype of a new signature, however many components are added
+		 * or removed. Components the entity keeps are moved, added ones are left for the caller to construct.
+		 * Shared components that are kept keep their value. Transitions of several components aren't cached on edges.
+		 * @param entityId Entity member id
+		 * @param record Record of the entity, updated to the new archetype and row
+		 * @param signature Signature of the entity afterwards
+		 * @return Pointer to the archetype the entity was moved to
+		 */
+		Archetype* ChangeSignature(EntityId entityId, EntityRecord& record, Signature signature);
 
 		/**
 		 * @brief Remove entity from archetype
-		 * @param[in] entity Readonly reference to entity
+		 * @param record Record of the entity, cleared afterwards
 		 */
-		void RemoveEntity(Entity const& entity);
+		void RemoveEntity(EntityRecord& record);
 
 		/**
 		 * @brief Get a vector of archetypes that shares common component types.
@@ -95,9 +177,71 @@ class ArchetypeManager
 		template <typename... T>
 		ArchetypeSet GetArchetypeSet();
 
+		/**
+		 * @brief Get the query of a set of component types, creating it on first use.
+		 * Prefer this over GetArchetypeSet for anything that runs every frame.
+		 * @return Reference to the query, owned by ArchetypeManager
+		 */
+		template <typename... T>
+		Query<T...>& GetQuery();
+
+		/**
+		 * @brief Get the version stamped on written chunk columns, the running system's version
+		 * or the global version outside of systems
+		 */
+		ChangeVersion GetVersion() const;
+
+		/**
+		 * @brief Take a version for a system that is about to run and move the global version forward.
+		 * Columns written by others afterwards compare greater than the returned version.
+		 * @return Version to stamp the system's own writes with, and to compare against on its next run
+		 */
+		ChangeVersion AdvanceVersion();
+
+		/**
+		 * @brief Set the version stamped by writes on the calling thread, 0 to use the global version
+		 * @param version Version from AdvanceVersion
+		 * @return Previous version of the thread
+		 */
+		static ChangeVersion SetThreadVersion(ChangeVersion version);
+
+		/**
+		 * @brief Get the number of times an entity was added to or removed from an archetype, starting at 1.
+		 * Components only move when it changes.
+		 */
+		uint32_t GetStructureVersion() const;
+
+		/**
+		 * @brief Record that a row was added or removed, invalidating every cached component pointer
+		 */
+		void AdvanceStructureVersion();
+
 	private:
 		ArchetypeManager();
-		std::unordered_map<Signature, Archetype> mSignatureToArchetypeMap;
+
+		/**
+		 * @brief Move an entity and the components it keeps to another archetype
+		 * @param entityId Entity member id
+		 * @param record Record of the entity, updated to the new archetype and row
+		 * @param to Archetype to move the entity to
+		 * @param columnMap Columns shared by both archetypes, from MapColumns
+		 * @return Pointer to the archetype the entity was moved to
+		 */
+		Archetype* MoveEntity(EntityId entityId, EntityRecord& record, Archetype* to, ColumnMap const& columnMap);
+
+		static thread_local ChangeVersion threadVersion;
+		std::atomic<ChangeVersion> mVersion;
+		uint32_t mStructureVersion; // Structural changes only happen on the main thread
+		std::unordered_map<ArchetypeKey, Archetype> mKeyToArchetypeMap;
+
+		// Edges taken by entities that have no components yet, by component index
+		std::unordered_map<size_t, ArchetypeEdge> mRootEdges;
+
+		std::unordered_map<std::type_index, std::unique_ptr<QueryBase>> mTypeToQueryMap;
+
+		// Archetypes found empty by the last CollectEmptyArchetypes
+		std::unordered_set<ArchetypeKey> mCollectableArchetypes;
+		ArchetypeStats mStats;
 };
 
 #include "ArchetypeManager.ipp"
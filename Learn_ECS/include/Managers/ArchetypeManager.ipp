@@ -2,38 +2,28 @@
 
 /**
  * @brief Add component data to an entity. This operation will move the entity to a new archetype.
- * @param entity Reference to an entity
+ * @param entityId Entity member id
+ * @param record Record of the entity, updated to the new archetype and row
+ * @param edge Add edge of the component, from GetAddEdge
  * @param component rvalue reference to component
+ * @return Pointer to the archetype the entity was moved to
  */
 template <typename T>
-void ArchetypeManager::AddComponent(Archetype* archetype, T&& component, Entity const& entity)
+Archetype* ArchetypeManager::AddComponent(EntityId entityId, EntityRecord& record, ArchetypeEdge const& edge, T&& component)
 {
-	EntityId entityId{ entity.GetId() };
-	archetype->AddEntity(entityId);
-	archetype->SetComponent(entityId, std::move(component));
+	// Edge belongs to "from", which is destroyed if the entity was its last
+	Archetype* from{ record.archetype };
+	size_t fromRow{ record.row };
+	Archetype* to{ edge.to };
+	size_t toRow{ to->AddEntity(entityId) };
+	to->EmplaceComponent(toRow, std::move(component));
+	record.archetype = to;
+	record.row = toRow;
 
-	Archetype* oldArchetype{ GetArchetype(entity.GetSignature()) };
-	if (!oldArchetype) return;
-	oldArchetype->MoveComponents(entityId, archetype);
-	oldArchetype->RemoveEntity(entityId);
-	oldArchetype = nullptr;
-}
-
-/**
- * @brief Remove component data from an entity. This operation will move the entity to a new archetype.
- * @param entity Reference to an entity
- */
-template <typename T>
-void ArchetypeManager::RemoveComponent(Archetype* archetype, Entity const& entity)
-{
-	EntityId entityId{ entity.GetId() };
-	archetype->AddEntity(entityId);
-
-	Archetype* oldArchetype{ GetArchetype(entity.GetSignature()) };
-	if (!oldArchetype) return;
-	oldArchetype->MoveComponents(entityId, archetype);
-	oldArchetype->RemoveEntity(entityId);
-	oldArchetype = nullptr;
+	if (!from) return to;
+	from->MoveComponents(fromRow, to, toRow, edge.columnMap);
+	from->RemoveEntity(fromRow);
+	return to;
 }
 
 /**
@@ -51,11 +41,30 @@ ArchetypeSet ArchetypeManager::GetArchetypeSet()
 
 	// TODO Reserve to MAX_COMPONENTS, completely arbitrary
 	archetypeSet.reserve(MAX_COMPONENTS);
-	for (auto& pair : mSignatureToArchetypeMap)
+	for (auto& pair : mKeyToArchetypeMap)
 	{
-		if ((pair.second.GetSignature() & signature) == signature)
+		if (pair.second.GetSignature().Contains(signature))
 			archetypeSet.push_back(&pair.second);
 	}
 
 	return archetypeSet;
 }
+
+/**
+ * @brief Get the query of a set of component types, creating it on first use.
+ * Prefer this over GetArchetypeSet for anything that runs every frame.
+ */
+template <typename... T>
+Query<T...>& ArchetypeManager::GetQuery()
+{
+	std::type_index type{ std::type_index(typeid(Query<T...>)) };
+	auto it{ mTypeToQueryMap.find(type) };
+	if (it == std::end(mTypeToQueryMap))
+	{
+		std::unique_ptr<QueryBase> query{ std::make_unique<Query<T...>>() };
+		for (auto& pair : mKeyToArchetypeMap)
+			query->Match(&pair.second);
+		it = mTypeToQueryMap.emplace(type, std::move(query)).first;
+	}
+	return static_cast<Query<T...>&>(*it->second);
+}
@@ -0,0 +1,75 @@
+/*************************************************************//**
+ * @file   ChunkManager.hpp
+ * @brief  Pool of fixed-size memory blocks used by archetypes to store components
+ *
+ * Key features:
+ * Is a Singleton
+ * Allocates CHUNK_SIZE blocks in batches so spawning doesn't hit the allocator per chunk
+ * Recycles chunks of empty archetypes instead of returning them to the OS
+ *
+ * Usage:
+ * std::byte* data{ ChunkManager::GetInstance().AllocateChunk() };
+ * ChunkManager::GetInstance().FreeChunk(data);
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef CHUNK_MANAGER_HPP
+#define CHUNK_MANAGER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Alias.hpp"
+
+class ChunkManager
+{
+	public:
+		/**
+		 * @brief Get the singleton instance
+		 */
+		static ChunkManager& GetInstance();
+
+		/**
+		 * @brief Delete copy constructor and copy assignment because singleton
+		 */
+		ChunkManager(ChunkManager const&) = delete;
+		ChunkManager& operator=(ChunkManager const&) = delete;
+
+		/**
+		 * @brief Get a CHUNK_SIZE block of memory aligned to CHUNK_ALIGNMENT
+		 * @return Pointer to the uninitialized chunk
+		 */
+		std::byte* AllocateChunk();
+
+		/**
+		 * @brief Return a chunk to the pool. Components in it must be destroyed already.
+		 * @param[in] chunk Pointer returned by AllocateChunk
+		 */
+		void FreeChunk(std::byte* chunk);
+
+		/**
+		 * @brief Get the number of chunks currently used by archetypes
+		 */
+		size_t GetUsedChunkCount() const;
+
+		/**
+		 * @brief Get the number of chunks waiting in the pool
+		 */
+		size_t GetFreeChunkCount() const;
+
+	private:
+		ChunkManager() = default;
+		~ChunkManager();
+
+		// Number of chunks allocated at once when the pool is empty
+		static constexpr size_t CHUNKS_PER_BLOCK{ 64 };
+
+		std::vector<std::byte*> mBlocks;
+		std::vector<std::byte*> mFreeChunks;
+};
+
+#endif // !CHUNK_MANAGER_HPP
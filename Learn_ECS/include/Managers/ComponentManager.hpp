@@ -5,12 +5,16 @@
  * Key features:
  * Is a Singleton
  * Register new components to the system
- * Get the signature of a particular component
+ * Get the signature of a particular component, without any lookup
  * Keeps track of the number of existing components
+ * Stores the size, alignment, move and destroy functions of each component type
+ * Empty types are tags, they are part of signatures but take no room in chunks
+ * Shared components are part of signatures too, their values live in SharedComponentManager
+ * Components deriving from ISoAComponent are stored one array per field, ComponentAccess hides the difference
  *
  * Usage:
  * Register components to the system. Unregistered components can't be used.
- * Convert types into bitsets. e.g. Passing type "Transform" returns 0000 0000 0000 0001
+ * Convert types into signatures. e.g. Passing type "Transform" returns {0}
  *
  * Dependencies:
  *
@@ -22,9 +26,140 @@
 #ifndef COMPONENT_MANAGER_HPP
 #define COMPONENT_MANAGER_HPP
 
-#include <typeindex>
-#include <unordered_map>
+#include <array>
+#include <type_traits>
+#include <memory>
+#include <vector>
 #include "Alias.hpp"
+#include "Interfaces/ISharedComponent.hpp"
+#include "Interfaces/ISoAComponent.hpp"
+
+struct MonoBehaviour;
+
+/**
+ * @brief Type actually stored in an archetype's column for component T.
+ * MonoBehaviours are polymorphic and have different sizes, so they are stored as owning pointers.
+ */
+template <typename T>
+using ComponentStorage = std::conditional_t<std::is_base_of_v<MonoBehaviour, T>, std::unique_ptr<MonoBehaviour>, T>;
+
+/**
+ * @brief Type a component is registered as. Every MonoBehaviour shares the MonoBehaviour column.
+ * References are stripped too, AddComponent deduces X& when it is given a named component.
+ */
+template <typename T>
+using ComponentKey = std::conditional_t<std::is_base_of_v<MonoBehaviour, std::remove_cv_t<std::remove_reference_t<T>>>,
+	MonoBehaviour, std::remove_cv_t<std::remove_reference_t<T>>>;
+
+/**
+ * @brief Component whose value is stored once per archetype, see ISharedComponent
+ */
+template <typename T>
+inline constexpr bool IsSharedComponent{ std::is_base_of_v<ISharedComponent, ComponentKey<T>> };
+
+/**
+ * @brief Component without data, e.g. struct Frozen {}. Tags filter queries but store nothing per entity.
+ * Components deriving from IComponent are never tags, IComponent has data.
+ */
+template <typename T>
+inline constexpr bool IsTagComponent{ std::is_empty_v<ComponentKey<T>> && !IsSharedComponent<T> };
+
+/**
+ * @brief How component T is reached in a chunk column. Array is what queries pass per chunk,
+ * Reference what they pass per entity and Pointer what GetComponent returns.
+ * Const components give const access, boxed MonoBehaviours are unboxed.
+ */
+template <typename T, bool = IsSoAComponent<T>>
+struct ComponentAccess
+{
+	using Array = std::conditional_t<std::is_const_v<T>, ComponentStorage<T> const, ComponentStorage<T>>*;
+	using Reference = T&;
+	using Pointer = T*;
+
+	/**
+	 * @brief Get the array of a column
+	 * @param address Address of the first component of the column
+	 * @param stride Unused, components are stored as whole structs
+	 */
+	static Array MakeArray(void* address, size_t stride);
+
+	/**
+	 * @brief Get the component at an index of an array
+	 */
+	static Reference GetElement(Array array, size_t index);
+
+	/**
+	 * @brief Get the pointer to a component
+	 * @param address Address of the component in its column
+	 * @param stride Unused, components are stored as whole structs
+	 */
+	static Pointer MakePointer(void* address, size_t stride);
+};
+
+template <typename T>
+struct ComponentAccess<T, true>
+{
+	using Array = SoAArrays<T>;
+	using Reference = SoARef<T>;
+	using Pointer = SoAPointer<T>;
+
+	/**
+	 * @brief Get the field arrays of a column
+	 * @param address Address of the first field of the first row
+	 * @param stride Bytes between two fields of the same row, from Chunk::GetFieldStride
+	 */
+	static Array MakeArray(void* address, size_t stride);
+
+	/**
+	 * @brief Get the fields at an index of the arrays
+	 */
+	static Reference GetElement(Array const& array, size_t index);
+
+	/**
+	 * @brief Get the fields of a component
+	 * @param address Address of the first field of the component
+	 * @param stride Bytes between two fields of the same row, from Chunk::GetFieldStride
+	 */
+	static Pointer MakePointer(void* address, size_t stride);
+};
+
+template <typename T>
+using ComponentArray = typename ComponentAccess<T>::Array;
+
+template <typename T>
+using ComponentReference = typename ComponentAccess<T>::Reference;
+
+template <typename T>
+using ComponentPointer = typename ComponentAccess<T>::Pointer;
+
+/**
+ * @brief Index of a component type, set once by ComponentManager::RegisterComponent.
+ * Use ComponentManager::GetComponentIndex, which also handles MonoBehaviours and const types.
+ */
+template <typename T>
+struct ComponentId
+{
+	static inline size_t index{ MAX_COMPONENTS };
+};
+
+/**
+ * @brief Type-erased information of a component type. Lets an archetype manage raw column memory.
+ */
+struct ComponentInfo
+{
+	size_t size{ 0 };
+	size_t alignment{ 0 };
+	void (*moveConstruct)(void* dst, void* src) { nullptr };
+	void (*copyConstruct)(void* dst, void const* src) { nullptr }; // nullptr if the component can't be copied
+	void (*setOwner)(void* component, EntityId entityId) { nullptr }; // nullptr if the component doesn't derive from IComponent
+	void (*destroy)(void* component) { nullptr };
+	char const* name{ nullptr };
+	bool isBoxed{ false }; // Stored as a pointer, the component itself never moves
+	bool isTriviallyCopyable{ false }; // Copied with memcpy instead of copyConstruct
+	bool isTag{ false }; // No data, size is 0 and the column takes no room in a chunk
+	bool isShared{ false }; // Value is stored by the archetype, size is 0 like tags
+	size_t fieldSize{ 0 }; // Stored one array per field when not 0, see ISoAComponent. The arrays take size bytes per row in total.
+};
 
 class ComponentManager
 {
@@ -51,16 +186,33 @@ class ComponentManager
 		template <typename T>
 		void RegisterComponent();
 
+		/**
+		 * @brief Gets the index of a component type, which is its bit in a signature.
+		 * @return Index of the component of type T.
+		 */
+		template <typename T>
+		static size_t GetComponentIndex();
+
 		/**
 		 * @brief Gets the signature of a component type.
 		 * @return Signature of the component of type T.
 		 */
 		template <typename T>
-		Signature GetSignature();
+		static Signature GetSignature();
+
+		/**
+		 * @brief Gets the type-erased information of a component.
+		 * @param[in] componentIndex Index of the component.
+		 * @return Readonly reference to the component information.
+		 */
+		ComponentInfo const& GetComponentInfo(size_t componentIndex) const;
 
 	private:
 		ComponentManager();
-		std::unordered_map<std::type_index, Signature> mTypeToSignatureMap;
+		size_t mComponentCount;
+
+		// Fixed array so archetypes can keep pointers to the information
+		std::array<ComponentInfo, MAX_COMPONENTS> mComponentInfos;
 };
 
 #include "ComponentManager.ipp"
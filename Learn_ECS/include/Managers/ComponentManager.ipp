@@ -1,6 +1,7 @@
 #include <iostream>
 #include <exception>
 #include <type_traits>
+#include <new>
 #include "Components/MonoBehaviour.hpp"
 
 /**
@@ -9,28 +10,152 @@
 template <typename T>
 void ComponentManager::RegisterComponent()
 {
-	std::type_index type{ std::type_index(typeid(T)) };
-	if (mTypeToSignatureMap.find(type) == std::end(mTypeToSignatureMap))
+	static_assert(std::is_same_v<ComponentKey<T>, T>, "Register MonoBehaviour once, scripts share its column.");
+	if (ComponentId<T>::index == MAX_COMPONENTS)
 	{
-		Signature signature{ 1ull << mTypeToSignatureMap.size() };
-		mTypeToSignatureMap[type] = signature;
-		std::cout << "Component Registered (" << mTypeToSignatureMap[type] << ": " << type.name() << ")\n";
+		if (mComponentCount == MAX_COMPONENTS)
+			throw std::exception{ "Too many component types, raise MAX_COMPONENTS." };
+
+		using Storage = ComponentStorage<T>;
+		size_t index{ mComponentCount++ };
+		ComponentId<T>::index = index;
+
+		ComponentInfo info{};
+		info.name = typeid(T).name();
+		info.isBoxed = !std::is_same_v<Storage, T>;
+		info.isTag = IsTagComponent<T>;
+		info.isShared = IsSharedComponent<T>;
+		if constexpr (IsTagComponent<T> || IsSharedComponent<T>)
+		{
+			// Nothing is ever constructed in the column
+			info.size = 0;
+			info.alignment = 1;
+			info.moveConstruct = [](void*, void*) {};
+			info.copyConstruct = [](void*, void const*) {};
+			info.destroy = [](void*) {};
+		}
+		else if constexpr (IsSoAComponent<T>)
+		{
+			// Rows are moved one field at a time by Archetype, there is nothing to construct or destroy
+			info.size = sizeof(T);
+			info.alignment = alignof(typename SoALayout<T>::Field);
+			info.fieldSize = sizeof(typename SoALayout<T>::Field);
+			info.isTriviallyCopyable = true;
+			info.moveConstruct = [](void*, void*) {};
+			info.copyConstruct = [](void*, void const*) {};
+			info.destroy = [](void*) {};
+		}
+		else
+		{
+			info.size = sizeof(Storage);
+			info.alignment = alignof(Storage);
+			info.moveConstruct = [](void* dst, void* src) { new (dst) Storage(std::move(*static_cast<Storage*>(src))); };
+			info.destroy = [](void* component) { static_cast<Storage*>(component)->~Storage(); };
+			info.isTriviallyCopyable = std::is_trivially_copyable_v<Storage>;
+
+			// Scripts are copied through their most derived type
+			if constexpr (!std::is_same_v<Storage, T>)
+				info.copyConstruct = [](void* dst, void const* src) { new (dst) Storage((*static_cast<Storage const*>(src))->Clone()); };
+			else if constexpr (std::is_copy_constructible_v<T>)
+				info.copyConstruct = [](void* dst, void const* src) { new (dst) Storage(*static_cast<Storage const*>(src)); };
+
+			if constexpr (!std::is_same_v<Storage, T>)
+				info.setOwner = [](void* component, EntityId entityId) { (*static_cast<Storage*>(component))->entityId = entityId; };
+			else if constexpr (std::is_base_of_v<IComponent, T>)
+				info.setOwner = [](void* component, EntityId entityId) { static_cast<T*>(component)->entityId = entityId; };
+		}
+		mComponentInfos[index] = info;
+
+		std::cout << "Component Registered (" << Signature{}.set(index) << ": " << info.name << ")\n";
 	}
 }
 
+/**
+ * @brief Gets the index of a component type, which is its bit in a signature.
+ */
+template <typename T>
+size_t ComponentManager::GetComponentIndex()
+{
+	size_t index{ ComponentId<ComponentKey<T>>::index };
+	if (index == MAX_COMPONENTS)
+		throw std::exception{ "Component not found." };
+	return index;
+}
+
 /**
  * @brief Gets the signature of a component type.
  */
 template <typename T>
 Signature ComponentManager::GetSignature()
 {
-	std::type_index type{ std::type_index(typeid(T)) };
+	return Signature{}.set(GetComponentIndex<T>());
+}
 
-	if (std::is_base_of<MonoBehaviour, T>::value)
-		type = std::type_index(typeid(MonoBehaviour));
+/**
+ * @brief Get the array of a column
+ * @param address Address of the first component of the column
+ * @param stride Unused, components are stored as whole structs
+ */
+template <typename T, bool IsSoA>
+typename ComponentAccess<T, IsSoA>::Array ComponentAccess<T, IsSoA>::MakeArray(void* address, size_t)
+{
+	return static_cast<Array>(address);
+}
 
-	auto it{ mTypeToSignatureMap.find(type) };
-	if (it == std::end(mTypeToSignatureMap))
-		throw std::exception{ "Component not found." };
-	return it->second;
+/**
+ * @brief Get the component at an index of an array
+ */
+template <typename T, bool IsSoA>
+typename ComponentAccess<T, IsSoA>::Reference ComponentAccess<T, IsSoA>::GetElement(Array array, size_t index)
+{
+	if constexpr (std::is_base_of_v<MonoBehaviour, T>)
+		return static_cast<T&>(*array[index]);
+	else
+		return array[index];
+}
+
+/**
+ * @brief Get the pointer to a component
+ * @param address Address of the component in its column
+ * @param stride Unused, components are stored as whole structs
+ */
+template <typename T, bool IsSoA>
+typename ComponentAccess<T, IsSoA>::Pointer ComponentAccess<T, IsSoA>::MakePointer(void* address, size_t)
+{
+	Array storage{ static_cast<Array>(address) };
+	if constexpr (std::is_base_of_v<MonoBehaviour, T>)
+		return static_cast<T*>(storage->get());
+	else
+		return storage;
+}
+
+/**
+ * @brief Get the field arrays of a column
+ * @param address Address of the first field of the first row
+ * @param stride Bytes between two fields of the same row, from Chunk::GetFieldStride
+ */
+template <typename T>
+typename ComponentAccess<T, true>::Array ComponentAccess<T, true>::MakeArray(void* address, size_t stride)
+{
+	return SoALayout<std::remove_const_t<T>>::MakeArrays(static_cast<std::conditional_t<std::is_const_v<T>, void const*, void*>>(address), stride);
+}
+
+/**
+ * @brief Get the fields at an index of the arrays
+ */
+template <typename T>
+typename ComponentAccess<T, true>::Reference ComponentAccess<T, true>::GetElement(Array const& array, size_t index)
+{
+	return SoALayout<std::remove_const_t<T>>::MakeRef(array, index);
+}
+
+/**
+ * @brief Get the fields of a component
+ * @param address Address of the first field of the component
+ * @param stride Bytes between two fields of the same row, from Chunk::GetFieldStride
+ */
+template <typename T>
+typename ComponentAccess<T, true>::Pointer ComponentAccess<T, true>::MakePointer(void* address, size_t stride)
+{
+	return Pointer{ GetElement(MakeArray(address, stride), 0) };
 }
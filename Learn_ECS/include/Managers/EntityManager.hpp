@@ -5,10 +5,19 @@
  * Key features:
  * Is a Singleton
  * Create and Get entities
+ * Create many entities with the same components at once
  * Get entity count
  * Add component to entity
  * Remove component from entity
- * Get component from entity
+ * Add or remove several components at once, moving the entity a single time
+ * Get component from entity, directly or as a ComponentRef that survives structural changes
+ * Set and get shared components, which move the entity to the archetype of the value
+ * Enable and disable entities without moving them, queries skip disabled entities
+ * Create prefabs and instantiate many copies of them at once
+ * Parent entities to each other, keeping Parent, Children and HierarchyDepth consistent
+ * Keeps a record of where every entity lives, indexed by EntityId
+ * Recycles the index of destroyed entities, the generation in the id catches stale ids
+ * Entities live in pages that never move, so references stay valid until the entity is destroyed
  *
  * Usage:
  * Use EntityManager to add, remove and get components
@@ -24,8 +33,15 @@
 #define ENTITY_MANAGER_HPP
 
 #include <vector>
-#include <unordered_map>
+#include <memory>
+#include <array>
+#include <tuple>
+#include <utility>
 #include "Entity.hpp"
+#include "Managers/ComponentManager.hpp"
+
+template <typename T>
+class ComponentRef;
 
 class EntityManager
 {
@@ -47,6 +63,40 @@ class EntityManager
 		 */
 		Entity& CreateEntity();
 
+		/**
+		 * @brief Create entities that all have the components T.... The archetype is resolved once
+		 * and every component is constructed directly in its column.
+		 * @param count Number of entities to create
+		 * @param initializer Called as initializer(i) for the i-th entity, returns std::tuple<T...>
+		 * @param sharedComponents Values of shared components, the same for every created entity
+		 */
+		template <typename... T, typename Func, typename... S>
+		void CreateEntities(size_t count, Func&& initializer, S const&... sharedComponents);
+
+		/**
+		 * @brief Create a prefab, an entity with the Prefab tag. Add its components like any entity,
+		 * queries skip it until it is copied with Instantiate.
+		 * @return A reference to the prefab.
+		 */
+		Entity& CreatePrefab();
+
+		/**
+		 * @brief Create copies of a prefab, without the Prefab tag. The archetype is resolved once
+		 * and every column is copied from the prefab's row.
+		 * @param prefab Entity created with CreatePrefab
+		 * @param count Number of copies
+		 */
+		void Instantiate(Entity const& prefab, size_t count);
+
+		/**
+		 * @brief Create copies of a prefab, then call initializer(i, Entity&) on the i-th copy
+		 * @param prefab Entity created with CreatePrefab
+		 * @param count Number of copies
+		 * @param initializer Called on every copy, e.g. to set its position
+		 */
+		template <typename Func>
+		void Instantiate(Entity const& prefab, size_t count, Func&& initializer);
+
 		/**
 		 * @brief Get an entity from it's ID.
 		 * @param[in] entityId ID of the entity
@@ -55,7 +105,14 @@ class EntityManager
 		Entity& GetEntity(EntityId entityId);
 
 		/**
-		 * @brief Destroy an entity.
+		 * @brief Check if an entity ID belongs to an existing entity.
+		 * IDs of destroyed entities stay invalid even after their index is reused.
+		 * @param[in] entityId ID of the entity
+		 */
+		bool IsAlive(EntityId entityId) const;
+
+		/**
+		 * @brief Destroy an entity. Its children are detached and become roots.
 		 * @paran[in] entity Reference to an entity
 		 */
 		void DestroyEntity(Entity const& entity);
@@ -66,6 +123,41 @@ class EntityManager
 		 */
 		size_t GetEntityCount() const;
 
+		/**
+		 * @brief Enable or disable an entity. Disabled entities keep their components and row,
+		 * but are skipped by Chunk::ForEachEnabledRange.
+		 * @param[in] entity Reference to entity
+		 * @param[in] isEnabled New state of the entity
+		 */
+		void SetEnabled(Entity const& entity, bool isEnabled);
+
+		/**
+		 * @brief Check if an entity is enabled. Entities without components are never enabled.
+		 * @param[in] entity Reference to entity
+		 */
+		bool IsEnabled(Entity const& entity);
+
+		/**
+		 * @brief Make an entity the child of another. Its Transform becomes relative to the parent.
+		 * Both entities get a LocalToWorld if they don't have one, and the child's subtree moves one level down.
+		 * @param[in] child Reference to the child entity
+		 * @param[in] parent Reference to the parent entity, can't be the child or one of its descendants
+		 */
+		void SetParent(Entity& child, Entity& parent);
+
+		/**
+		 * @brief Detach an entity from its parent. Its Transform becomes relative to the world.
+		 * @param[in] child Reference to the child entity
+		 */
+		void RemoveParent(Entity& child);
+
+		/**
+		 * @brief Get the record of where an entity lives
+		 * @param[in] entityId ID of the entity
+		 * @return Reference to the record
+		 */
+		EntityRecord& GetRecord(EntityId entityId);
+
 		/**
 		 * @brief Add component to entity
 		 * @param entity Reference to entity
@@ -89,11 +181,43 @@ class EntityManager
 		void RemoveComponent(Entity& entity);
 
 		/**
-		 * @brief Get the reference to the component of an entity
+		 * @brief Add default constructed components to entity, moving it to its final archetype once
+		 * @param entity Reference to entity
+		 */
+		template <typename... T>
+		void AddComponents(Entity& entity);
+
+		/**
+		 * @brief Add components to entity, moving it to its final archetype once.
+		 * Components the entity already has are left unchanged, like AddComponent.
+		 * @param entity Reference to entity
+		 * @param components Components to add
+		 */
+		template <typename... T>
+		void AddComponents(Entity& entity, T... components);
+
+		/**
+		 * @brief Remove components from entity, moving it to its final archetype once
+		 * @param entity Reference to entity
+		 */
+		template <typename... T>
+		void RemoveComponents(Entity& entity);
+
+		/**
+		 * @brief Get the pointer to the component of an entity. Only valid until the next structural change,
+		 * use GetComponentRef to hold on to it. Components deriving from ISoAComponent give a SoAPointer.
+		 * Ask for T const to read without marking the chunk as changed.
 		 * @param entity Reference to entity
 		 */
 		template <typename T>
-		T* GetComponent(Entity const& entity, T** handle);
+		ComponentPointer<T> GetComponent(Entity const& entity);
+
+		/**
+		 * @brief Get a reference to the component of an entity that stays valid when the entity moves
+		 * @param entity Reference to entity
+		 */
+		template <typename T>
+		ComponentRef<T> GetComponentRef(Entity const& entity);
 
 		/**
 		 * @brief Set component data
@@ -103,12 +227,76 @@ class EntityManager
 		template <typename T>
 		void SetComponent(Entity& entity, T&& component);
 
+		/**
+		 * @brief Add a shared component to an entity, or change its value
+		 * @param entity Reference to entity
+		 * @param component Value of the shared component, stored once by SharedComponentManager
+		 */
+		template <typename T>
+		void SetSharedComponent(Entity& entity, T const& component);
+
+		/**
+		 * @brief Get the value of a shared component of an entity
+		 * @param entity Reference to entity
+		 * @return Pointer to the value, or nullptr if the entity doesn't have the shared component
+		 */
+		template <typename T>
+		T const* GetSharedComponent(Entity const& entity);
+
 	private:
+		static constexpr size_t ENTITIES_PER_PAGE{ 1'024 };
+
+		/**
+		 * @brief Storage of an entity index. Keeps the last id while free so the generation can be bumped.
+		 */
+		struct EntitySlot
+		{
+			Entity entity;
+			EntityRecord record;
+			bool isAlive{ false };
+		};
+
 		EntityManager();
-		uint32_t mIdCounter;
-		std::vector<Entity> mEntities;
-		std::unordered_map<EntityId, size_t> mEntityIdToIndexMap;
-		std::unordered_map<size_t, EntityId> mIndexToEntityIdMap;
+
+		/**
+		 * @brief Construct the components of a newly created entity, used by CreateEntities
+		 */
+		template <typename... T, size_t... I>
+		static void EmplaceComponents(Archetype* archetype, size_t row, std::array<size_t, sizeof...(T)> const& columns,
+			std::tuple<T...>& components, EntityId entityId, std::index_sequence<I...>);
+
+		/**
+		 * @brief Copy a prefab into new entities, used by Instantiate
+		 * @return Ids of the copies, empty if the prefab can't be copied
+		 */
+		std::vector<EntityId> CopyPrefab(Entity const& prefab, size_t count);
+
+		/**
+		 * @brief Set the HierarchyDepth of an entity and of its descendants, used by SetParent and RemoveParent
+		 */
+		void SetDepth(Entity& entity, uint32_t depth);
+
+		/**
+		 * @brief Remove an entity from the Children of its parent
+		 */
+		void RemoveChildId(EntityId parentId, EntityId childId);
+
+		/**
+		 * @brief Tell a component which entity owns it. Tags and plain data don't need to know.
+		 */
+		template <typename T>
+		static void SetOwner(T& component, EntityId entityId);
+
+		/**
+		 * @brief Get the slot of an entity index
+		 */
+		EntitySlot& GetSlot(size_t index);
+		EntitySlot const& GetSlot(size_t index) const;
+
+		std::vector<std::unique_ptr<EntitySlot[]>> mPages;
+		std::vector<size_t> mFreeIndices;
+		size_t mSlotCount;   // Indices handed out at least once
+		size_t mEntityCount; // Entities alive
 };
 
 #include "Managers/EntityManager.ipp"
@@ -1,8 +1,87 @@
 #include <iostream>
+#include <algorithm>
 #include "Interfaces/IComponent.hpp"
 #include "Managers/ArchetypeManager.hpp"
 #include "Managers/ComponentManager.hpp"
-#include "Managers/HandleManager.hpp"
+#include "Managers/SharedComponentManager.hpp"
+#include "ComponentRef.hpp"
+
+/**
+ * @brief Create entities that all have the components T.... The archetype is resolved once
+ * and every component is constructed directly in its column.
+ * @param count Number of entities to create
+ * @param initializer Called as initializer(i) for the i-th entity, returns std::tuple<T...>
+ * @param sharedComponents Values of shared components, the same for every created entity
+ */
+template <typename... T, typename Func, typename... S>
+void EntityManager::CreateEntities(size_t count, Func&& initializer, S const&... sharedComponents)
+{
+	static_assert((!IsSharedComponent<T> && ...), "Pass shared components after the initializer.");
+	static_assert((IsSharedComponent<S> && ...), "Only shared components can be passed after the initializer.");
+	ComponentManager& cm{ ComponentManager::GetInstance() };
+	Signature signature{ 0 };
+	((signature |= cm.GetSignature<T>()), ...);
+	((signature |= cm.GetSignature<S>()), ...);
+
+	SharedComponentManager& scm{ SharedComponentManager::GetInstance() };
+	SharedValues sharedValues{ { cm.GetComponentIndex<S>(), scm.AddValue(sharedComponents) }... };
+	std::sort(std::begin(sharedValues), std::end(sharedValues));
+
+	Archetype* archetype{ ArchetypeManager::GetInstance().CreateArchetype(signature, sharedValues) };
+	std::array<size_t, sizeof...(T)> columns{ archetype->GetColumnIndex(cm.GetComponentIndex<T>())... };
+	archetype->Reserve(count);
+
+	for (size_t i{}; i < count; ++i)
+	{
+		Entity& entity{ CreateEntity() };
+		EntityId entityId{ entity.GetId() };
+		std::tuple<T...> components{ initializer(i) };
+
+		size_t row{ archetype->AddEntity(entityId) };
+		EmplaceComponents(archetype, row, columns, components, entityId, std::index_sequence_for<T...>{});
+		entity.SetSignature(signature);
+
+		EntityRecord& record{ GetRecord(entityId) };
+		record.archetype = archetype;
+		record.row = row;
+	}
+}
+
+/**
+ * @brief Create copies of a prefab, then call initializer(i, Entity&) on the i-th copy
+ * @param prefab Entity created with CreatePrefab
+ * @param count Number of copies
+ * @param initializer Called on every copy, e.g. to set its position
+ */
+template <typename Func>
+void EntityManager::Instantiate(Entity const& prefab, size_t count, Func&& initializer)
+{
+	// Ids instead of rows, the initializer may move the copies to other archetypes
+	std::vector<EntityId> entityIds{ CopyPrefab(prefab, count) };
+	for (size_t i{}; i < entityIds.size(); ++i)
+		initializer(i, GetEntity(entityIds[i]));
+}
+
+/**
+ * @brief Construct the components of a newly created entity, used by CreateEntities
+ */
+template <typename... T, size_t... I>
+void EntityManager::EmplaceComponents(Archetype* archetype, size_t row, std::array<size_t, sizeof...(T)> const& columns,
+	std::tuple<T...>& components, EntityId entityId, std::index_sequence<I...>)
+{
+	(SetOwner(std::get<I>(components), entityId), ...);
+	(archetype->EmplaceComponent(row, columns[I], std::move(std::get<I>(components))), ...);
+}
+
+/**
+ * @brief Tell a component which entity owns it. Tags and plain data don't need to know.
+ */
+template <typename T>
+void EntityManager::SetOwner(T& component, EntityId entityId)
+{
+	if constexpr (std::is_base_of_v<IComponent, T>)
+		static_cast<IComponent&>(component).entityId = entityId;
+}
 
 /**
  * @brief Add component to entity
@@ -22,25 +101,21 @@ void EntityManager::AddComponent(Entity& entity)
 template <typename T>
 void EntityManager::AddComponent(Entity& entity, T&& component)
 {
-	Signature componentSignature{ ComponentManager::GetInstance().GetSignature<T>() };
+	static_assert(!IsSharedComponent<T>, "Use SetSharedComponent for shared components.");
+	size_t componentIndex{ ComponentManager::GetComponentIndex<T>() };
 	Signature oldArchSignature{ entity.GetSignature() };
-	Signature newArchSignature{ oldArchSignature | componentSignature };
 
 	// If entity already has the component
-	if (newArchSignature == oldArchSignature) return;
+	if (oldArchSignature.test(componentIndex)) return;
 
+	EntityId entityId{ entity.GetId() };
+	EntityRecord& record{ GetRecord(entityId) };
 	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	Archetype* newArchetype{ am.CreateArchetype(newArchSignature) };
-	if (newArchetype == nullptr)
-	{
-		std::cout << __FUNCTION__ << " Failed to create Archetype: " << newArchSignature << std::endl;
-		return;
-	}
+	ArchetypeEdge const& edge{ am.GetAddEdge(record.archetype, componentIndex) };
 
-	static_cast<IComponent&>(component).entityId = entity.GetId();
-	am.AddComponent(newArchetype, std::move(component), entity);
-	entity.SetSignature(newArchSignature);
-	HandleManager::GetInstance().UpdateEntityHandles(entity);
+	SetOwner(component, entityId);
+	Archetype* newArchetype{ am.AddComponent(entityId, record, edge, std::move(component)) };
+	entity.SetSignature(newArchetype->GetSignature());
 }
 
 /**
@@ -50,41 +125,122 @@ void EntityManager::AddComponent(Entity& entity, T&& component)
 template <typename T>
 void EntityManager::RemoveComponent(Entity& entity)
 {
-	Signature componentSignature{ ComponentManager::GetInstance().GetSignature<T>() };
+	size_t componentIndex{ ComponentManager::GetComponentIndex<T>() };
 	Signature oldArchSignature{ entity.GetSignature() };
 
 	// If entity doesn't have the component
-	if ((oldArchSignature & componentSignature) == 0) return;
+	if (!oldArchSignature.test(componentIndex)) return;
+
+	EntityId entityId{ entity.GetId() };
+	EntityRecord& record{ GetRecord(entityId) };
+	if (record.archetype == nullptr)
+	{
+		std::cout << __FUNCTION__ << " Archetype: " << oldArchSignature << " not found.\n";
+		return;
+	}
 
-	Signature newArchSignature{ oldArchSignature ^ componentSignature };
 	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	Archetype* newArchetype{ am.CreateArchetype(newArchSignature) };
-	if (newArchetype == nullptr)
+	ArchetypeEdge const& edge{ am.GetRemoveEdge(record.archetype, componentIndex) };
+	Archetype* newArchetype{ am.RemoveComponent(entityId, record, edge) };
+	entity.SetSignature(newArchetype->GetSignature());
+}
+
+/**
+ * @brief Add default constructed components to entity, moving it to its final archetype once
+ * @param entity Reference to entity
+ */
+template <typename... T>
+void EntityManager::AddComponents(Entity& entity)
+{
+	AddComponents<T...>(entity, T{}...);
+}
+
+/**
+ * @brief Add components to entity, moving it to its final archetype once.
+ * Components the entity already has are left unchanged, like AddComponent.
+ * @param entity Reference to entity
+ * @param components Components to add
+ */
+template <typename... T>
+void EntityManager::AddComponents(Entity& entity, T... components)
+{
+	static_assert((!IsSharedComponent<T> && ...), "Use SetSharedComponent for shared components.");
+	ComponentManager& cm{ ComponentManager::GetInstance() };
+	Signature addedSignature{ 0 };
+	((addedSignature |= cm.GetSignature<T>()), ...);
+	Signature oldSignature{ entity.GetSignature() };
+
+	// If entity already has every component
+	if (oldSignature.Contains(addedSignature)) return;
+
+	EntityId entityId{ entity.GetId() };
+	EntityRecord& record{ GetRecord(entityId) };
+	Archetype* newArchetype{ ArchetypeManager::GetInstance().ChangeSignature(entityId, record, oldSignature | addedSignature) };
+	size_t row{ record.row };
+	(SetOwner(components, entityId), ...);
+
+	// Only the new columns are unconstructed, the moved ones already hold the entity's components
+	auto emplace = [&](auto& component)
+	{
+		using Component = std::decay_t<decltype(component)>;
+		size_t componentIndex{ ComponentManager::GetComponentIndex<Component>() };
+		if (!oldSignature.test(componentIndex))
+			newArchetype->EmplaceComponent(row, newArchetype->GetColumnIndex(componentIndex), std::move(component));
+	};
+	(emplace(components), ...);
+	entity.SetSignature(newArchetype->GetSignature());
+}
+
+/**
+ * @brief Remove components from entity, moving it to its final archetype once
+ * @param entity Reference to entity
+ */
+template <typename... T>
+void EntityManager::RemoveComponents(Entity& entity)
+{
+	ComponentManager& cm{ ComponentManager::GetInstance() };
+	Signature removedSignature{ 0 };
+	((removedSignature |= cm.GetSignature<T>()), ...);
+	Signature oldArchSignature{ entity.GetSignature() };
+
+	// If entity has none of the components
+	if ((oldArchSignature & removedSignature).none()) return;
+
+	EntityId entityId{ entity.GetId() };
+	EntityRecord& record{ GetRecord(entityId) };
+	if (record.archetype == nullptr)
 	{
-		std::cout << __FUNCTION__ << " Archetype: " << newArchSignature << " not found.\n";
+		std::cout << __FUNCTION__ << " Archetype: " << oldArchSignature << " not found.\n";
 		return;
 	}
 
-	am.RemoveComponent<T>(newArchetype, entity);
-	entity.SetSignature(newArchSignature);
-	HandleManager::GetInstance().UpdateEntityHandles(entity);
+	Archetype* newArchetype{ ArchetypeManager::GetInstance().ChangeSignature(entityId, record, oldArchSignature & ~removedSignature) };
+	entity.SetSignature(newArchetype->GetSignature());
 }
 
 /**
- * @brief Get the reference to the component of an entity
+ * @brief Get the pointer to the component of an entity. Only valid until the next structural change,
+ * use GetComponentRef to hold on to it. Components deriving from ISoAComponent give a SoAPointer.
+ * Ask for T const to read without marking the chunk as changed.
  * @param entity Reference to entity
- * @param[in] handle Handle of the pointer to the component
  */
 template <typename T>
-T* EntityManager::GetComponent(Entity const& entity, T** handle)
+ComponentPointer<T> EntityManager::GetComponent(Entity const& entity)
 {
-	EntityId entityId{ entity.GetId() };
-	Signature componentSignature{ ComponentManager::GetInstance().GetSignature<T>() };
-	HandleManager::GetInstance().AddHandle(entityId, componentSignature, reinterpret_cast<void**>(handle));
+	static_assert(!IsSharedComponent<T>, "Use GetSharedComponent for shared components.");
+	EntityRecord const& record{ GetRecord(entity.GetId()) };
+	if (record.archetype == nullptr) return nullptr;
+	return record.archetype->GetComponent<T>(record.row, ComponentManager::GetComponentIndex<T>());
+}
 
-	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	Archetype* archetype{ am.GetArchetype(entity.GetSignature()) };
-	return archetype->GetComponent<T>(entityId, componentSignature);
+/**
+ * @brief Get a reference to the component of an entity that stays valid when the entity moves
+ * @param entity Reference to entity
+ */
+template <typename T>
+ComponentRef<T> EntityManager::GetComponentRef(Entity const& entity)
+{
+	return ComponentRef<T>{ entity.GetId() };
 }
 
 /**
@@ -95,8 +251,38 @@ T* EntityManager::GetComponent(Entity const& entity, T** handle)
 template <typename T>
 void EntityManager::SetComponent(Entity& entity, T&& component)
 {
-	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	Archetype* archetype{ am.GetArchetype(entity.GetSignature()) };
+	static_assert(!IsSharedComponent<std::decay_t<T>>, "Use SetSharedComponent for shared components.");
+	EntityRecord const& record{ GetRecord(entity.GetId()) };
+	if (record.archetype == nullptr) return;
+	record.archetype->SetComponent(record.row, std::move(component));
+}
+
+/**
+ * @brief Add a shared component to an entity, or change its value
+ * @param entity Reference to entity
+ * @param component Value of the shared component, stored once by SharedComponentManager
+ */
+template <typename T>
+void EntityManager::SetSharedComponent(Entity& entity, T const& component)
+{
+	size_t componentIndex{ ComponentManager::GetComponentIndex<T>() };
+	uint32_t valueIndex{ SharedComponentManager::GetInstance().AddValue(component) };
+
 	EntityId entityId{ entity.GetId() };
-	return archetype->SetComponent(entityId, std::move(component));
+	EntityRecord& record{ GetRecord(entityId) };
+	Archetype* newArchetype{ ArchetypeManager::GetInstance().SetSharedComponent(entityId, record, componentIndex, valueIndex) };
+	entity.SetSignature(newArchetype->GetSignature());
+}
+
+/**
+ * @brief Get the value of a shared component of an entity
+ * @param entity Reference to entity
+ * @return Pointer to the value, or nullptr if the entity doesn't have the shared component
+ */
+template <typename T>
+T const* EntityManager::GetSharedComponent(Entity const& entity)
+{
+	EntityRecord const& record{ GetRecord(entity.GetId()) };
+	if (record.archetype == nullptr) return nullptr;
+	return record.archetype->GetSharedComponent<T>();
 }
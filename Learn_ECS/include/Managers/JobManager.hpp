@@ -0,0 +1,131 @@
+/*************************************************************//**
+ * @file   JobManager.hpp
+ * @brief  Pool of worker threads that run jobs for the engine
+ *
+ * Key features:
+ * Is a Singleton
+ * Starts one worker per hardware thread, minus the main thread
+ * Every thread pushes and pops its own queue, idle threads steal from the others
+ * Wait on a counter while helping with the queued jobs
+ * Split a range of work across the threads with ParallelFor
+ *
+ * Usage:
+ * std::atomic<size_t> remaining{ 1 };
+ * JobManager::GetInstance().Schedule([&remaining]() { ...; --remaining; });
+ * JobManager::GetInstance().Wait(remaining);
+ *
+ * JobManager::GetInstance().ParallelFor(count, [](size_t begin, size_t end) { ... });
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef JOB_MANAGER_HPP
+#define JOB_MANAGER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobManager
+{
+	public:
+		using Job = std::function<void()>;
+
+		/**
+		 * @brief Get the singleton instance
+		 */
+		static JobManager& GetInstance();
+
+		/**
+		 * @brief Delete copy constructor and copy assignment because singleton
+		 */
+		JobManager(JobManager const&) = delete;
+		JobManager& operator=(JobManager const&) = delete;
+
+		/**
+		 * @brief Queue a job on the calling thread's queue, it will be run by
+		 * this thread or stolen by another one
+		 * @param job Function to run
+		 */
+		void Schedule(Job job);
+
+		/**
+		 * @brief Run queued jobs on the calling thread until the counter reaches zero
+		 * @param[in] counter Decremented by the jobs being waited on
+		 */
+		void Wait(std::atomic<size_t> const& counter);
+
+		/**
+		 * @brief Get the number of worker threads, 0 if jobs only run while waiting
+		 */
+		size_t GetWorkerCount() const;
+
+		/**
+		 * @brief Splits [0, count) into ranges and calls func(begin, end) for each of them
+		 * on every thread, returns once all ranges are done.
+		 * @param count Number of items
+		 * @param func Function called with a range of items
+		 */
+		template <typename Func>
+		void ParallelFor(size_t count, Func&& func);
+
+	private:
+		// Ranges per thread in ParallelFor, so threads that finish early can steal the rest
+		static constexpr size_t RANGES_PER_THREAD{ 4 };
+
+		struct JobQueue
+		{
+			std::mutex mutex;
+			std::deque<Job> jobs;
+		};
+
+		JobManager();
+		~JobManager();
+
+		/**
+		 * @brief Loop of every worker thread
+		 * @param index Index of the worker's own queue
+		 */
+		void WorkerLoop(size_t index);
+
+		/**
+		 * @brief Pop a job from the calling thread's queue, or steal one, and run it
+		 * @return false if there was no job
+		 */
+		bool TryRunJob();
+
+		/**
+		 * @brief Take the newest job of a queue
+		 */
+		bool PopJob(size_t index, Job& job);
+
+		/**
+		 * @brief Take the oldest job of a queue
+		 */
+		bool StealJob(size_t index, Job& job);
+
+		// Queue of the calling thread, 0 for the main thread and any thread that isn't a worker
+		static thread_local size_t queueIndex;
+
+		std::vector<std::thread> mWorkers;
+		std::vector<std::unique_ptr<JobQueue>> mQueues;
+		std::atomic<size_t> mJobCount;
+
+		// Idle workers sleep until a job is scheduled
+		std::mutex mSleepMutex;
+		std::condition_variable mCondition;
+		bool mIsStopping;
+};
+
+#include "Managers/JobManager.ipp"
+
+#endif // !JOB_MANAGER_HPP
@@ -0,0 +1,36 @@
+#include <algorithm>
+
+/**
+ * @brief Splits [0, count) into ranges and calls func(begin, end) for each of them
+ * on every thread, returns once all ranges are done.
+ * @param count Number of items
+ * @param func Function called with a range of items
+ */
+template <typename Func>
+void JobManager::ParallelFor(size_t count, Func&& func)
+{
+	size_t rangeCount{ std::min(count, (mWorkers.size() + 1) * RANGES_PER_THREAD) };
+	if (rangeCount <= 1)
+	{
+		if (count > 0) func(size_t{ 0 }, count);
+		return;
+	}
+
+	// The first range is run by the calling thread
+	size_t rangeSize{ count / rangeCount };
+	size_t remainder{ count % rangeCount };
+	std::atomic<size_t> remaining{ rangeCount - 1 };
+	size_t begin{ rangeSize + (remainder > 0 ? 1 : 0) };
+	for (size_t r{ 1 }; r < rangeCount; ++r)
+	{
+		size_t end{ begin + rangeSize + (r < remainder ? 1 : 0) };
+		Schedule([&func, &remaining, begin, end]()
+		{
+			func(begin, end);
+			remaining.fetch_sub(1, std::memory_order_acq_rel);
+		});
+		begin = end;
+	}
+	func(size_t{ 0 }, rangeSize + (remainder > 0 ? 1 : 0));
+	Wait(remaining);
+}
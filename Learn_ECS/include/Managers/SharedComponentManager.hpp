@@ -0,0 +1,83 @@
+/*************************************************************//**
+ * @file   SharedComponentManager.hpp
+ * @brief  Manager of the values of shared components
+ *
+ * Key features:
+ * Is a Singleton
+ * Stores each distinct value of a shared component type once
+ * Values are identified by an index, which archetypes use as part of their identity
+ * Values never move, so pointers to them stay valid
+ *
+ * Usage:
+ * uint32_t valueIndex{ SharedComponentManager::GetInstance().AddValue(texture) };
+ * Texture const& texture{ SharedComponentManager::GetInstance().GetValue<Texture>(valueIndex) };
+ *
+ * Dependencies:
+ * Shared component types need an operator==.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef SHARED_COMPONENT_MANAGER_HPP
+#define SHARED_COMPONENT_MANAGER_HPP
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include "Alias.hpp"
+
+class SharedComponentManager
+{
+	public:
+		/**
+		 * @brief Get the singleton instance
+		 */
+		static SharedComponentManager& GetInstance();
+
+		/**
+		 * @brief Delete copy constructor and copy assignment because singleton
+		 */
+		SharedComponentManager(SharedComponentManager const&) = delete;
+		SharedComponentManager& operator=(SharedComponentManager const&) = delete;
+
+		/**
+		 * @brief Get the index of a value, storing it first if no equal value is stored yet.
+		 * Values are few (textures, materials), so they are compared one by one.
+		 * @param[in] value Value of a shared component
+		 * @return Index of the value among the values of type T
+		 */
+		template <typename T>
+		uint32_t AddValue(T const& value);
+
+		/**
+		 * @brief Get a stored value
+		 * @param[in] valueIndex Index from AddValue
+		 */
+		template <typename T>
+		T const& GetValue(uint32_t valueIndex) const;
+
+	private:
+		SharedComponentManager();
+
+		struct IValueList
+		{
+			virtual ~IValueList() = default;
+		};
+
+		// Deque so that adding a value doesn't move the others
+		template <typename T>
+		struct ValueList : IValueList
+		{
+			std::deque<T> values;
+		};
+
+		// Indexed by component index, created when the first value of the type is added
+		std::array<std::unique_ptr<IValueList>, MAX_COMPONENTS> mValueLists;
+};
+
+#include "SharedComponentManager.ipp"
+
+#endif // !SHARED_COMPONENT_MANAGER_HPP
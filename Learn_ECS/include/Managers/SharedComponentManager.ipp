@@ -0,0 +1,36 @@
+#include <algorithm>
+#include "Managers/ComponentManager.hpp"
+
+/**
+ * @brief Get the index of a value, storing it first if no equal value is stored yet.
+ * Values are few (textures, materials), so they are compared one by one.
+ * @param[in] value Value of a shared component
+ * @return Index of the value among the values of type T
+ */
+template <typename T>
+uint32_t SharedComponentManager::AddValue(T const& value)
+{
+	static_assert(IsSharedComponent<T>, "Only types deriving from ISharedComponent have shared values.");
+	std::unique_ptr<IValueList>& valueList{ mValueLists[ComponentManager::GetComponentIndex<T>()] };
+	if (!valueList)
+		valueList = std::make_unique<ValueList<T>>();
+
+	std::deque<T>& values{ static_cast<ValueList<T>&>(*valueList).values };
+	auto it{ std::find(std::begin(values), std::end(values), value) };
+	if (it != std::end(values))
+		return static_cast<uint32_t>(it - std::begin(values));
+
+	values.push_back(value);
+	return static_cast<uint32_t>(values.size() - 1);
+}
+
+/**
+ * @brief Get a stored value
+ * @param[in] valueIndex Index from AddValue
+ */
+template <typename T>
+T const& SharedComponentManager::GetValue(uint32_t valueIndex) const
+{
+	IValueList const& valueList{ *mValueLists[ComponentManager::GetComponentIndex<T>()] };
+	return static_cast<ValueList<T> const&>(valueList).values[valueIndex];
+}
@@ -5,7 +5,8 @@
  * Key features:
  * Add a system to a vector of system
  * Initialize all systems in the vector
- * Update all systems in the vector
+ * Update all systems in the vector, systems that don't share written components run in parallel
+ * Play back the command buffers once every system is updated
  *
  * Usage:
  *
@@ -23,7 +24,9 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <atomic>
 #include "Interfaces/ISystem.hpp"
+#include "CommandBuffer.hpp"
 
 class SystemManager
 {
@@ -42,11 +45,31 @@ class SystemManager
 		static void InitSystems();
 
 		/**
-		 * @brief Updates all system in the systems static member.
+		 * @brief Updates all system in the systems static member, then plays back the command buffers.
+		 * Systems are ordered by the components they access, in the order they were added when they conflict.
 		 * Is called every frame.
 		 */
 		static void UpdateSystems();
 
+		/**
+		 * @brief Gets the command buffer of the system running on this thread,
+		 * or the shared one outside of UpdateSystems.
+		 * @return Reference to the command buffer
+		 */
+		static CommandBuffer& GetCommandBuffer();
+
+		/**
+		 * @brief Run the systems one at a time in the order they were added. Deterministic, for debugging.
+		 * @param[in] parallel false to run serially
+		 */
+		static void SetParallel(bool parallel);
+
+		/**
+		 * @brief Gets the version the running system had on its previous update, 0 if it never ran.
+		 * Columns written since then compare greater, see Query::ForEachChangedChunk.
+		 */
+		static ChangeVersion GetLastVersion();
+
 		/**
 		 * @brief Gets a system by name
 		 * @param[in] systemName Name of the system
@@ -57,6 +80,38 @@ class SystemManager
 	private:
 		static std::vector<std::shared_ptr<ISystem>> systems;
 		static std::unordered_map<std::string, std::shared_ptr<ISystem>> stringToSystemMap;
+		static CommandBuffer commandBuffer;
+
+		// One command buffer per system, played back in the order the systems were added
+		static std::vector<std::unique_ptr<CommandBuffer>> systemCommandBuffers;
+		static thread_local CommandBuffer* currentCommandBuffer;
+
+		// Version of every system's previous update
+		static std::vector<ChangeVersion> systemVersions;
+		static thread_local ChangeVersion lastVersion;
+
+		// Dependency graph of the current frame
+		static std::vector<std::vector<size_t>> dependents;
+		static std::unique_ptr<std::atomic<size_t>[]> dependencyCounts;
+		static std::atomic<size_t> remainingSystems;
+		static bool isParallel;
+
+		/**
+		 * @brief Check if two systems can't run at the same time
+		 */
+		static bool IsConflicting(SystemAccess const& lhs, SystemAccess const& rhs);
+
+		/**
+		 * @brief Update a system with its own command buffer and version
+		 * @param[in] index Index of the system
+		 */
+		static void UpdateSystem(size_t index);
+
+		/**
+		 * @brief Update a system, then schedule the systems that were waiting on it
+		 * @param[in] index Index of the system
+		 */
+		static void RunSystem(size_t index);
 };
 
 #endif // !SYSTEM_MANAGER_HPP
@@ -0,0 +1,210 @@
+/*************************************************************//**
+ * @file   Query.hpp
+ * @brief  Cached list of archetypes that contain a set of component types.
+ *
+ * Key features:
+ * Registered once with ArchetypeManager, which keeps it matched as archetypes are created and destroyed
+ * Stores the column of every queried component for each matching archetype
+ * Iterates the matching chunks without allocating
+ * Iterates the matching chunks in parallel with JobManager
+ * Stamps the columns of non-const component types as written, const ones are readonly
+ * Skips the chunks whose columns didn't change since a version with ForEachChangedChunk
+ * Tags filter the archetypes like any component, their array holds nothing and shouldn't be read
+ * Shared components can't be queried, every chunk has one value of them, see Chunk::GetSharedComponent
+ * Prefabs are skipped unless the Prefab tag is queried
+ * Chunks whose entities are all disabled are skipped, loop with Chunk::ForEachEnabledRange to skip the others
+ * Calls a function per enabled entity with ForEach, the arrays are resolved once per chunk
+ * Components deriving from ISoAComponent are passed as field arrays per chunk and field references per entity
+ * Reports its const component types as reads and the others as writes, for SystemAccess
+ *
+ * Usage:
+ * Query<Transform, Rigidbody2D>& query{ ArchetypeManager::GetInstance().GetQuery<Transform, Rigidbody2D>() };
+ * query.ForEachChunk([](Chunk& chunk, SoAArrays<Transform> tv, Rigidbody2D* rv)
+ * {
+ *     chunk.ForEachEnabledRange([&](size_t begin, size_t end) { for (size_t i{ begin }; i < end; ++i) ... });
+ * });
+ * query.ParallelForEachChunk([](size_t firstEntity, Chunk& chunk, SoAArrays<Transform> tv, Rigidbody2D* rv) { ... });
+ * query.ForEach([](SoARef<Transform> transform, Rigidbody2D& rb) { ... });
+ *
+ * Query<Transform const, SpriteRenderer const>& readQuery{ ... };
+ * readQuery.ForEachChangedChunk<Transform>(SystemManager::GetLastVersion(), [](Chunk& chunk, SoAArrays<Transform const> tv, SpriteRenderer const* srv) { ... });
+ *
+ * Dependencies:
+ * Components have to be registered before the query is created.
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include "Alias.hpp"
+#include "Archetype.hpp"
+#include "Interfaces/ISystem.hpp"
+
+class QueryBase
+{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param[in] componentIndices Index of every queried component, in the order of the columns
+		 */
+		QueryBase(std::vector<size_t> componentIndices);
+		virtual ~QueryBase() = default;
+
+		/**
+		 * @brief Queries are referenced by systems, so they can't be copied
+		 */
+		QueryBase(QueryBase const&) = delete;
+		QueryBase& operator=(QueryBase const&) = delete;
+
+		/**
+		 * @brief Get the combined signature of the queried components
+		 */
+		Signature GetSignature() const;
+
+		/**
+		 * @brief Get the archetypes that contain every queried component
+		 * @return Readonly reference to the vector of archetypes
+		 */
+		ArchetypeSet const& GetArchetypes() const;
+
+		/**
+		 * @brief Get the number of entities in the matching archetypes
+		 */
+		size_t GetEntityCount() const;
+
+		/**
+		 * @brief Get the columns of the queried components in a matching archetype
+		 * @param[in] archetypeIndex Index of the archetype in GetArchetypes()
+		 * @return Pointer to one column per queried component
+		 */
+		size_t const* GetColumns(size_t archetypeIndex) const;
+
+		/**
+		 * @brief Add an archetype to the query if it contains every queried component.
+		 * Prefabs only match queries that ask for the Prefab tag.
+		 * @param archetype Newly created archetype
+		 */
+		void Match(Archetype* archetype);
+
+		/**
+		 * @brief Remove an archetype from the query
+		 * @param archetype Archetype that is about to be destroyed
+		 */
+		void Unmatch(Archetype* archetype);
+
+	protected:
+		/**
+		 * @brief Get the version stamped on the columns written by the calling thread
+		 */
+		static ChangeVersion GetWriteVersion();
+
+		Signature mSignature;
+		std::vector<size_t> mComponentIndices;
+		ArchetypeSet mArchetypes;
+
+		// mComponentIndices.size() columns per archetype, in the order of mArchetypes
+		std::vector<size_t> mColumns;
+};
+
+/**
+ * @brief Component types can be const qualified, their columns are then passed as const arrays
+ * and aren't stamped as written.
+ */
+template <typename... T>
+class Query : public QueryBase
+{
+	static_assert((!IsSharedComponent<T> && ...), "Shared components have no array, read them with Chunk::GetSharedComponent.");
+
+	public:
+		template <typename U>
+		using Array = ComponentArray<U>;
+
+		/**
+		 * @brief Constructor. Use ArchetypeManager::GetQuery so the query is kept up to date.
+		 */
+		Query();
+
+		/**
+		 * @brief Calls func(Chunk&, ComponentArray<T>...) for every chunk of the matching archetypes
+		 * with at least one enabled entity. Adding or removing components inside func is not allowed.
+		 * @param func Function called with the chunk and its component arrays
+		 */
+		template <typename Func>
+		void ForEachChunk(Func&& func);
+
+		/**
+		 * @brief Same as ForEachChunk, but skips the chunks where none of the U columns were written after a version.
+		 * Every U has to be one of the query's component types.
+		 * @param version Version to compare with, usually the reader's version of its last run
+		 * @param func Function called with the chunk and its component arrays
+		 */
+		template <typename... U, typename Func>
+		void ForEachChangedChunk(ChangeVersion version, Func&& func);
+
+		/**
+		 * @brief Calls func(size_t firstEntity, Chunk&, ComponentArray<T>...) for every chunk of the
+		 * matching archetypes with at least one enabled entity, split across JobManager's threads. firstEntity is the index of the chunk's
+		 * first entity in ForEachChunk order, for writing per-entity results without locking.
+		 * Returns once every chunk is done. Only the chunk's own components may be written.
+		 * @param func Function called with the entity offset, the chunk and its component arrays
+		 */
+		template <typename Func>
+		void ParallelForEachChunk(Func&& func);
+
+		/**
+		 * @brief Calls func(T&...) for every enabled entity of the matching archetypes. The arrays are resolved once
+		 * per chunk and func is called in a plain loop over them, which the compiler can inline and vectorize.
+		 * Components deriving from ISoAComponent are passed as SoARef<T>.
+		 * Adding or removing components inside func is not allowed.
+		 * @param func Function called with the components of an entity
+		 */
+		template <typename Func>
+		void ForEach(Func&& func);
+
+		/**
+		 * @brief Same as ForEach, but the chunks are split across JobManager's threads.
+		 * Returns once every entity is done. Only the entity's own components may be written.
+		 * @param func Function called with the components of an entity
+		 */
+		template <typename Func>
+		void ParallelForEach(Func&& func);
+
+		/**
+		 * @brief Get the components the query touches, const component types are read and the others written
+		 * @return Access of the query, not exclusive
+		 */
+		static SystemAccess GetAccess();
+
+	private:
+		/**
+		 * @brief Whether U is one of the query's component types, const or not
+		 */
+		template <typename U>
+		static constexpr bool HasComponent{ (std::is_same_v<ComponentKey<U>, ComponentKey<T>> || ...) };
+
+		/**
+		 * @brief Stamp the columns of the non-const component types as written
+		 */
+		template <size_t... I>
+		static void MarkWritten(Chunk& chunk, size_t const* columns, ChangeVersion version, std::index_sequence<I...>);
+
+		template <typename Func, size_t... I>
+		static void CallWithArrays(Func& func, Chunk& chunk, size_t const* columns, std::index_sequence<I...>);
+
+		template <typename Func, size_t... I>
+		static void CallWithArrays(Func& func, size_t firstEntity, Chunk& chunk, size_t const* columns, std::index_sequence<I...>);
+
+		template <typename Func, size_t... I>
+		static void CallPerEntity(Func& func, Chunk& chunk, size_t const* columns, std::index_sequence<I...>);
+};
+
+#include "Query.ipp"
+
+#endif // !QUERY_HPP
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include "Managers/ComponentManager.hpp"
+#include "Managers/JobManager.hpp"
+
+/**
+ * @brief Constructor. Use ArchetypeManager::GetQuery so the query is kept up to date.
+ */
+template <typename... T>
+Query<T...>::Query() :
+	QueryBase{ { ComponentManager::GetComponentIndex<T>()... } }
+{}
+
+/**
+ * @brief Calls func(Chunk&, ComponentArray<T>...) for every chunk of the matching archetypes
+ * with at least one enabled entity. Adding or removing components inside func is not allowed.
+ * @param func Function called with the chunk and its component arrays
+ */
+template <typename... T>
+template <typename Func>
+void Query<T...>::ForEachChunk(Func&& func)
+{
+	ChangeVersion version{ GetWriteVersion() };
+	for (size_t a{}; a < mArchetypes.size(); ++a)
+	{
+		size_t const* columns{ GetColumns(a) };
+		for (Chunk& chunk : mArchetypes[a]->GetChunks())
+		{
+			if (chunk.GetEnabledCount() == 0) continue;
+
+			MarkWritten(chunk, columns, version, std::index_sequence_for<T...>{});
+			CallWithArrays(func, chunk, columns, std::index_sequence_for<T...>{});
+		}
+	}
+}
+
+/**
+ * @brief Same as ForEachChunk, but skips the chunks where none of the U columns were written after a version.
+ * Every U has to be one of the query's component types.
+ * @param version Version to compare with, usually the reader's version of its last run
+ * @param func Function called with the chunk and its component arrays
+ */
+template <typename... T>
+template <typename... U, typename Func>
+void Query<T...>::ForEachChangedChunk(ChangeVersion version, Func&& func)
+{
+	static_assert(sizeof...(U) > 0, "ForEachChangedChunk needs at least one component type to check.");
+	static_assert((HasComponent<U> && ...),
+		"ForEachChangedChunk can only check components of the query, others have no column in its archetypes.");
+	ChangeVersion writeVersion{ GetWriteVersion() };
+	for (size_t a{}; a < mArchetypes.size(); ++a)
+	{
+		size_t const* columns{ GetColumns(a) };
+		Archetype* archetype{ mArchetypes[a] };
+		std::array<size_t, sizeof...(U)> changedColumns{ archetype->GetColumnIndex(ComponentManager::GetComponentIndex<U>())... };
+		for (Chunk& chunk : archetype->GetChunks())
+		{
+			if (chunk.GetEnabledCount() == 0) continue;
+
+			bool isChanged{ false };
+			for (size_t column : changedColumns)
+				isChanged = isChanged || chunk.GetChangeVersion(column) > version;
+			if (!isChanged) continue;
+
+			MarkWritten(chunk, columns, writeVersion, std::index_sequence_for<T...>{});
+			CallWithArrays(func, chunk, columns, std::index_sequence_for<T...>{});
+		}
+	}
+}
+
+/**
+ * @brief Calls func(size_t firstEntity, Chunk&, ComponentArray<T>...) for every chunk of the
+ * matching archetypes with at least one enabled entity, split across JobManager's threads. firstEntity is the index of the chunk's
+ * first entity in ForEachChunk order, for writing per-entity results without locking.
+ * Returns once every chunk is done. Only the chunk's own components may be written.
+ * @param func Function called with the entity offset, the chunk and its component arrays
+ */
+template <typename... T>
+template <typename Func>
+void Query<T...>::ParallelForEachChunk(Func&& func)
+{
+	// Chunks of every matching archetype are numbered one after another
+	size_t archetypeCount{ mArchetypes.size() };
+	std::vector<size_t> firstChunks(archetypeCount + 1);
+	std::vector<size_t> firstEntities(archetypeCount);
+	for (size_t a{}, entityCount{}; a < archetypeCount; ++a)
+	{
+		firstChunks[a + 1] = firstChunks[a] + mArchetypes[a]->GetChunks().size();
+		firstEntities[a] = entityCount;
+		entityCount += mArchetypes[a]->GetEntityCount();
+	}
+
+	ChangeVersion version{ GetWriteVersion() };
+	JobManager::GetInstance().ParallelFor(firstChunks[archetypeCount], [&](size_t begin, size_t end)
+	{
+		size_t a{ static_cast<size_t>(std::upper_bound(std::begin(firstChunks), std::end(firstChunks), begin) - std::begin(firstChunks)) - 1 };
+		for (size_t c{ begin }; c < end; ++c)
+		{
+			while (c >= firstChunks[a + 1]) ++a;
+
+			Archetype* archetype{ mArchetypes[a] };
+			size_t chunkIndex{ c - firstChunks[a] };
+			Chunk& chunk{ archetype->GetChunks()[chunkIndex] };
+			if (chunk.GetEnabledCount() == 0) continue;
+
+			// Every chunk but the last one of an archetype is full
+			size_t firstEntity{ firstEntities[a] + chunkIndex * archetype->GetChunkCapacity() };
+			MarkWritten(chunk, GetColumns(a), version, std::index_sequence_for<T...>{});
+			CallWithArrays(func, firstEntity, chunk, GetColumns(a), std::index_sequence_for<T...>{});
+		}
+	});
+}
+
+/**
+ * @brief Calls func(T&...) for every enabled entity of the matching archetypes. The arrays are resolved once
+ * per chunk and func is called in a plain loop over them, which the compiler can inline and vectorize.
+ * Components deriving from ISoAComponent are passed as SoARef<T>.
+ * Adding or removing components inside func is not allowed.
+ * @param func Function called with the components of an entity
+ */
+template <typename... T>
+template <typename Func>
+void Query<T...>::ForEach(Func&& func)
+{
+	static_assert((!IsTagComponent<std::remove_const_t<T>> && ...), "Tags have no data to pass, filter on them with ForEachChunk.");
+	ChangeVersion version{ GetWriteVersion() };
+	for (size_t a{}; a < mArchetypes.size(); ++a)
+	{
+		size_t const* columns{ GetColumns(a) };
+		for (Chunk& chunk : mArchetypes[a]->GetChunks())
+		{
+			if (chunk.GetEnabledCount() == 0) continue;
+
+			MarkWritten(chunk, columns, version, std::index_sequence_for<T...>{});
+			CallPerEntity(func, chunk, columns, std::index_sequence_for<T...>{});
+		}
+	}
+}
+
+/**
+ * @brief Same as ForEach, but the chunks are split across JobManager's threads.
+ * Returns once every entity is done. Only the entity's own components may be written.
+ * @param func Function called with the components of an entity
+ */
+template <typename... T>
+template <typename Func>
+void Query<T...>::ParallelForEach(Func&& func)
+{
+	static_assert((!IsTagComponent<std::remove_const_t<T>> && ...), "Tags have no data to pass, filter on them with ParallelForEachChunk.");
+	ParallelForEachChunk([&func](size_t, Chunk& chunk, Array<T>... arrays)
+	{
+		chunk.ForEachEnabledRange([&](size_t begin, size_t end)
+		{
+			for (size_t i{ begin }; i < end; ++i)
+				func(ComponentAccess<T>::GetElement(arrays, i)...);
+		});
+	});
+}
+
+/**
+ * @brief Get the components the query touches, const component types are read and the others written
+ * @return Access of the query, not exclusive
+ */
+template <typename... T>
+SystemAccess Query<T...>::GetAccess()
+{
+	SystemAccess access{};
+	(((std::is_const_v<T> ? access.reads : access.writes) |= ComponentManager::GetSignature<std::remove_const_t<T>>()), ...);
+	access.isExclusive = false;
+	return access;
+}
+
+template <typename... T>
+template <typename Func, size_t... I>
+void Query<T...>::CallWithArrays(Func& func, Chunk& chunk, size_t const* columns, std::index_sequence<I...>)
+{
+	func(chunk, chunk.GetComponentArray<T>(columns[I])...);
+}
+
+template <typename... T>
+template <typename Func, size_t... I>
+void Query<T...>::CallWithArrays(Func& func, size_t firstEntity, Chunk& chunk, size_t const* columns, std::index_sequence<I...>)
+{
+	func(firstEntity, chunk, chunk.GetComponentArray<T>(columns[I])...);
+}
+
+template <typename... T>
+template <typename Func, size_t... I>
+void Query<T...>::CallPerEntity(Func& func, Chunk& chunk, size_t const* columns, std::index_sequence<I...>)
+{
+	std::tuple<Array<T>...> arrays{ chunk.GetComponentArray<T>(columns[I])... };
+	chunk.ForEachEnabledRange([&](size_t begin, size_t end)
+	{
+		for (size_t i{ begin }; i < end; ++i)
+			func(ComponentAccess<T>::GetElement(std::get<I>(arrays), i)...);
+	});
+}
+
+template <typename... T>
+template <size_t... I>
+void Query<T...>::MarkWritten(Chunk& chunk, size_t const* columns, ChangeVersion version, std::index_sequence<I...>)
+{
+	((std::is_const_v<T> ? void() : chunk.MarkChanged(columns[I], version)), ...);
+}
@@ -6,10 +6,14 @@
  * Key features:
  * Renders quads by MAX_QUADS amount. Each instance of quad will have their own
  * transform matrices, UVs, texture units, and color.
+ * Matrices are read from LocalToWorld, computed by TransformSystem.
+ * UVs are cached per chunk and only recomputed when the chunk's SpriteRenderers change.
  *
  * Usage:
  *
  * Dependencies:
+ * Only entities with LocalToWorld, SpriteRenderer and a Texture shared component are drawn.
+ * Add LocalToWorld next to Transform, sprites missing either are skipped with a message the first time.
  *
  * @author HONG Xian Xiang
  * @date   3rd October 2024
@@ -23,10 +27,14 @@
 #include <glm/glm.hpp>
 #include <cstdint>
 #include <unordered_map>
-#include "Components/Transform.hpp"
+#include <vector>
+#include "Components/LocalToWorld.hpp"
 #include "Components/SpriteRenderer.hpp"
 #include "Alias.hpp"
 
+template <typename... T>
+class Query;
+
 class QuadInstancedRenderer
 {
 	private:
@@ -57,7 +65,25 @@ class QuadInstancedRenderer
 		static GLfloat samplers[MAX_QUADS];
 		static glm::vec2 uvs[MAX_VERTS];
 		static glm::mat3 transforms[MAX_QUADS];
+
+		/**
+		 * @brief UVs of the quads of a chunk, kept until the chunk's SpriteRenderers change
+		 */
+		struct ChunkCache
+		{
+			std::vector<glm::vec2> uvs;
+			size_t frame{ 0 }; // Last frame the chunk was rendered
+		};
+
+		// Keyed by the chunk's SpriteRenderer array, which stays put for the chunk's lifetime
+		static std::unordered_map<SpriteRenderer const*, ChunkCache> chunkCaches;
+		static ChangeVersion lastVersion;
+		static size_t frameCount;
 		static std::unordered_map<TextureId, GLfloat> texIdToSamplerMap;
+		static Query<LocalToWorld const, SpriteRenderer const>* query;
+		static Query<SpriteRenderer const>* spriteQuery; // Every sprite, to report the ones query misses
+		static bool isMissingLocalToWorldReported;
+		static bool isMissingTextureReported;
 
 		/**
 		 * @brief Initialize the shaders for instanced quad rendering
@@ -69,20 +95,13 @@ class QuadInstancedRenderer
 		 */
 		static void InitBuffers();
 
-		/**
-		 * @brief Calculates the Model-to-World matrix from the Transform component which
-		 * will be sent to the GPU.
-		 * @param[in,out] transform A reference to a 3x3 Matrix which will be sent to the GPU.
-		 * @param[in]     component A read-only reference to the Transform component.
-		 */
-		static void CalculateTransform(glm::mat3& transform, Transform const& component);
-
 		/**
 		 * @brief Calculates the UVs for all 4 vertices for each quad, using the given sprite sheet.
 		 * @param[in,out] uv A pointer to the UV value of the first vertex.
 		 * @param[in]     component A read-only reference to the SpriteRenderer component.
+		 * @param[in]     texture A read-only reference to the sprite sheet, shared by the chunk.
 		 */
-		static void CalculateUVs(glm::vec2* uv, SpriteRenderer const& component);
+		static void CalculateUVs(glm::vec2* uv, SpriteRenderer const& component, Texture const& texture);
 
 		/**
 		 * @brief Activate texture units for the shader.
@@ -18,11 +18,18 @@
 #define ZOMBIE_HPP
 
 #include "Components/MonoBehaviour.hpp"
+#include "ComponentRef.hpp"
+#include "Components/Transform.hpp"
+#include "Components/Animator.hpp"
 
 class Zombie : public MonoBehaviour
 {
 	void Start() override;
 	void Update() override;
+	std::unique_ptr<MonoBehaviour> Clone() const override;
+
+	ComponentRef<Transform> transform;
+	ComponentRef<Animator> animator;
 };
 
 #endif // !ZOMBIE_HPP
@@ -21,16 +21,36 @@
 
 #include "Interfaces/ISystem.hpp"
 
+template <typename... T>
+class Query;
+struct Animator;
+struct SpriteRenderer;
+
 class AnimatorSystem : public ISystem
 {
+	public:
+	/**
+	 * @brief Constructor. Components must be registered before the system is created.
+	 */
+	AnimatorSystem();
+
+	private:
 	void Init() override;
 
 	/**
 	 * @brief Loops through entities containing an Animator and SpriteRenderer component.
 	 * Updates the SpriteRenderer's row and column, which decides which sprite to display.
 	 * Will not update SpriteRenderer if Animator is paused or stopped.
+	 * SpriteRenderer is only marked as changed in the chunks where a frame was advanced.
 	 */
 	void Update() override;
+
+	/**
+	 * @brief Writes Animator and SpriteRenderer
+	 */
+	SystemAccess GetAccess() const override;
+
+	Query<Animator, SpriteRenderer const>& mQuery;
 };
 
 #endif // !ANIMATOR_SYSTEM_HPP
@@ -24,8 +24,8 @@ public:
 	void Update();
 
 private:
-	void InitAStar(Enemy& enemy, Transform& transform);
-	void AStar(Enemy& enemy, Transform& transform);
+	void InitAStar(Enemy& enemy, SoARef<Transform> transform);
+	void AStar(Enemy& enemy, SoARef<Transform> transform);
 	std::vector<std::pair<Node, float>> GetNeighbours(Node& currentNode);
 	float Heuristic(const Node& node, std::pair<float, float> targetLoc);
 };
@@ -21,17 +21,33 @@
 
 #include "Interfaces/ISystem.hpp"
 
+template <typename... T>
+class Query;
+struct MonoBehaviour;
+
 class MonoBehaviourSystem : public ISystem
 {
+	public:
+	/**
+	 * @brief Constructor. Components must be registered before the system is created.
+	 */
+	MonoBehaviourSystem();
+
+	private:
 	/**
 	 * @brief Simply calls Start() of all MonoBehaviours
 	 */
 	void Init() override;
 
 	/**
-	 * @brief Simply calls Update() of all MonoBehaviours
+	 * @brief Simply calls Update() of all MonoBehaviours.
+	 * Scripts write through the pointers they kept in Start(), so their chunks are marked as changed.
 	 */
 	void Update() override;
+
+	// Scripts can touch any component, so GetAccess is left exclusive
+
+	Query<MonoBehaviour>& mQuery;
 };
 
 #endif // !MONO_BEHAVIOUR_SYSTEM_HPP
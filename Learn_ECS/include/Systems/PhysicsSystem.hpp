@@ -17,27 +17,35 @@
 #ifndef PHYSICS_SYSTEM_HPP
 #define PHYSICS_SYSTEM_HPP
 
-class PhysicsSystem
+#include "Interfaces/ISystem.hpp"
+#include "Components/Transform.hpp"
+
+template <typename... T>
+class Query;
+struct Rigidbody2D;
+
+class PhysicsSystem : public ISystem
 {
 	public:
-		static PhysicsSystem& GetInstance()
-		{
-			static PhysicsSystem instance;
-			return instance;
-		}
-
-		PhysicsSystem(PhysicsSystem const&) = delete;
-		PhysicsSystem& operator=(PhysicsSystem const&) = delete;
+		/**
+		 * @brief Constructor. Components must be registered before the system is created.
+		 */
+		PhysicsSystem();
 
-		void Init();
+		void Init() override;
 
 		/**
 		 * @brief Updates the physical properties of objects like position, velocity, and rotation.
 		 */
-		void Update();
+		void Update() override;
+
+		/**
+		 * @brief Writes Transform, reads Rigidbody2D
+		 */
+		SystemAccess GetAccess() const override;
 
 	private:
-		PhysicsSystem() = default;
+		Query<Transform, Rigidbody2D const>& mQuery;
 };
 
 #endif // !PHYSICS_SYSTEM_HPP
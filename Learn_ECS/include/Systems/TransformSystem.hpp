@@ -0,0 +1,76 @@
+/*************************************************************//**
+ * @file   TransformSystem.hpp
+ * @brief  Computes the LocalToWorld of every entity from its Transform and its parent's LocalToWorld.
+ *
+ * Key features:
+ * Entities are grouped in chunks by HierarchyDepth, so each level is a run of whole chunks
+ * Levels are computed from the roots down, every parent is done before its children read it
+ * Chunks of a level are split across JobManager's threads
+ * Roots whose Transform didn't change are skipped
+ *
+ * Usage:
+ * Added after the systems that write Transform, so the renderer reads this frame's matrices.
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#ifndef TRANSFORM_SYSTEM_HPP
+#define TRANSFORM_SYSTEM_HPP
+
+#include <vector>
+#include <utility>
+#include "Interfaces/ISystem.hpp"
+#include "Components/Transform.hpp"
+
+template <typename... T>
+class Query;
+class Chunk;
+struct LocalToWorld;
+
+class TransformSystem : public ISystem
+{
+	public:
+		/**
+		 * @brief Constructor. Components must be registered before the system is created.
+		 */
+		TransformSystem();
+
+		void Init() override;
+
+		/**
+		 * @brief Computes the LocalToWorld of every entity, one hierarchy level at a time
+		 */
+		void Update() override;
+
+		/**
+		 * @brief Writes LocalToWorld, reads Transform, Parent and HierarchyDepth
+		 */
+		SystemAccess GetAccess() const override;
+
+	private:
+		/**
+		 * @brief Compute the LocalToWorld of the entities of a root chunk
+		 */
+		static void UpdateRoots(Chunk& chunk, SoAArrays<Transform const> tv, LocalToWorld* lv);
+
+		/**
+		 * @brief Compute the LocalToWorld of the entities of a child chunk, relative to their parents
+		 */
+		static void UpdateChildren(Chunk& chunk, SoAArrays<Transform const> tv, LocalToWorld* lv);
+
+		/**
+		 * @brief Fill the matrix of a LocalToWorld from its world position and angle, and the size (w, h) of the Transform
+		 */
+		static void CalculateMatrix(LocalToWorld& localToWorld, float w, float h);
+
+		Query<Transform const, LocalToWorld>& mQuery;
+
+		// (Depth, chunk) of the current update, sorted by depth. Kept to reuse its memory.
+		std::vector<std::pair<uint32_t, Chunk*>> mChunks;
+};
+
+#endif // !TRANSFORM_SYSTEM_HPP
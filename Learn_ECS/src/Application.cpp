@@ -27,6 +27,7 @@
 #include "Managers/SystemManager.hpp"
 #include "Managers/EntityManager.hpp"
 #include "Managers/ComponentManager.hpp"
+#include "Managers/ArchetypeManager.hpp"
 #include "Managers/AssetManager.hpp"
 
 #include "Components/Transform.hpp"
@@ -34,12 +35,14 @@
 #include "Components/SpriteRenderer.hpp"
 #include "Components/Texture.hpp"
 #include "Components/Animator.hpp"
+#include "Components/LocalToWorld.hpp"
 
 #include "Systems/InputSystem.hpp"
 #include "Systems/PhysicsSystem.hpp"
 #include "Systems/GraphicSystem.hpp"
 #include "Systems/AnimatorSystem.hpp"
 #include "Systems/MonoBehaviourSystem.hpp"
+#include "Systems/TransformSystem.hpp"
 
 #include "Scripts/Zombie.hpp"
 
@@ -73,6 +76,11 @@ void Application::Init()
 	ComponentManager::GetInstance().Init();
 	GraphicSystem::GetInstance().Init();
 
+	// Input and graphics stay on the main thread, the rest is scheduled by SystemManager
+	SystemManager::AddSystem(
+		std::make_shared<PhysicsSystem>(),
+		"PhysicsSystem"
+	);
 	SystemManager::AddSystem(
 		std::make_shared<MonoBehaviourSystem>(),
 		"MonoBehaviourSystem"
@@ -81,6 +89,10 @@ void Application::Init()
 		std::make_shared<AnimatorSystem>(),
 		"AnimatorSystem"
 	);
+	SystemManager::AddSystem(
+		std::make_shared<TransformSystem>(),
+		"TransformSystem"
+	);
 	SystemManager::InitSystems();
 }
 
@@ -127,29 +139,25 @@ void Application::Run()
 {
 	InputSystem& inputSystem{ InputSystem::GetInstance() };
 	GraphicSystem& graphicSystem{ GraphicSystem::GetInstance() };
-	PhysicsSystem& physicsSystem{ PhysicsSystem::GetInstance() };
 	EntityManager& entityManager{ EntityManager::GetInstance() };
 
 	// Zombie textures
 	Texture const& texture1 = AssetManager::GetInstance().LoadTexture("Assets/EternityPainter.png");
 	Texture const& texture2 = AssetManager::GetInstance().LoadTexture("Assets/Panddo.png");
 
-	// Load entities
-	Entity& entity{ entityManager.CreateEntity() };
-	entityManager.AddComponent<Transform>(entity, Transform{ 0.f, 0.f, 0.f, 500.f, 500.f });
-	entityManager.AddComponent<SpriteRenderer>(entity, SpriteRenderer{ texture1 });
-	entityManager.AddComponent<Animator>(entity, Animator{});
-	entityManager.AddComponent<Zombie>(entity, Zombie{}); // TODO maybe change this (MonoBehaviour base class points to this instead?)
+	// Zombie prefab
+	Entity& zombiePrefab{ entityManager.CreatePrefab() };
+	entityManager.AddComponents(zombiePrefab, Transform{ 0.f, 0.f, 0.f, 500.f, 500.f }, LocalToWorld{}, SpriteRenderer{}, Animator{},
+		Zombie{}); // TODO maybe change this (MonoBehaviour base class points to this instead?)
+	entityManager.SetSharedComponent(zombiePrefab, texture1);
 
 	// Set cell
-	SpriteRenderer* sr{ nullptr };
-	sr = entityManager.GetComponent<SpriteRenderer>(entity, &sr);
+	SpriteRenderer* sr{ entityManager.GetComponent<SpriteRenderer>(zombiePrefab) };
 	sr->cellWidth = 100;
 	sr->cellHeight = 100;
 
 	// Define sprite animation
-	Animator* animator{ nullptr };
-	animator = entityManager.GetComponent<Animator>(entity, &animator);
+	Animator* animator{ entityManager.GetComponent<Animator>(zombiePrefab) };
 	animator->AddAnimation("Walk");
 	Animation& animation{ animator->GetAnimation("Walk") };
 	animation.AddFrame(9, 0);
@@ -162,12 +170,25 @@ void Application::Run()
 	animation.AddFrame(2, 0);
 	animator->Play("Walk");
 
+	// Load entities
+	entityManager.Instantiate(zombiePrefab, 1);
+
+	// Falling sprite prefab, only the transform differs between copies
+	Entity& spritePrefab{ entityManager.CreatePrefab() };
+	SpriteRenderer spriteRenderer{};
+	spriteRenderer.cellWidth = 32;
+	spriteRenderer.cellHeight = 32;
+	entityManager.AddComponents(spritePrefab, Transform{ 0.f, 0.f, 0.f, 100.f, 100.f }, LocalToWorld{}, Rigidbody2D{ 50.f, 50.f },
+		std::move(spriteRenderer));
+	entityManager.SetSharedComponent(spritePrefab, texture2);
+
 	// Call Start() to all MonoBehaviours
 	auto& monoBehaviourSystem{ SystemManager::GetSystem("MonoBehaviourSystem")};
 	monoBehaviourSystem->Init();
 
 	double timer1{ 0.0 };
 	double timer2{ 0.0 };
+	double collectTimer{ 0.0 };
 	while (!glfwWindowShouldClose(Application::GetWindow()))
 	{
 		Time::Update();
@@ -179,19 +200,13 @@ void Application::Run()
 		timer1 += Time::deltaTime;
 		if (timer1 >= 1.0)
 		{
-			for (int i{}; i < 10000; ++i)
+			entityManager.Instantiate(spritePrefab, 10000, [&entityManager](size_t, Entity& entity)
 			{
-				Entity& entity2{ entityManager.CreateEntity() };
-				float x{ Random::RandomFloat(-Application::WIDTH / 2.f, Application::WIDTH / 2.f) };
-				float y{ Application::HEIGHT / 2.f + Random::RandomFloat(50.f, 100.f) };
-				float a{ Random::RandomFloat(-3.1415f / 18.f, 3.1415f / 18.f) };
-				entityManager.AddComponent<Transform>(entity2, Transform{ x, y, a, 100.f, 100.f });
-				entityManager.AddComponent<Rigidbody2D>(entity2, Rigidbody2D{ 50.f, 50.f });
-				entityManager.AddComponent<SpriteRenderer>(entity2, SpriteRenderer{ texture2 });
-				sr = entityManager.GetComponent<SpriteRenderer>(entity2, &sr);
-				sr->cellWidth = 32;
-				sr->cellHeight = 32;
-			}
+				SoAPointer<Transform> transform{ entityManager.GetComponent<Transform>(entity) };
+				transform->x = Random::RandomFloat(-Application::WIDTH / 2.f, Application::WIDTH / 2.f);
+				transform->y = Application::HEIGHT / 2.f + Random::RandomFloat(50.f, 100.f);
+				transform->a = Random::RandomFloat(-3.1415f / 18.f, 3.1415f / 18.f);
+			});
 			timer1 = 0.0;
 		}
 
@@ -214,8 +229,15 @@ void Application::Run()
 		// [x] Draw
 
 		inputSystem.Update();
-		physicsSystem.Update();
 		SystemManager::UpdateSystems();
+
+		collectTimer += Time::deltaTime;
+		if (collectTimer >= ARCHETYPE_COLLECT_INTERVAL)
+		{
+			ArchetypeManager::GetInstance().CollectEmptyArchetypes(ARCHETYPE_COLLECT_BUDGET);
+			collectTimer = 0.0;
+		}
+
 		Application::Update();
 		graphicSystem.Update();
 		graphicSystem.Draw();
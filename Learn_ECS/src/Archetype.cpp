@@ -3,12 +3,19 @@
  * @brief  Function definition in Archetype class
  *
  * Key features:
- * Construct an archetype with a particular signature. Each signature will be assigned a vector of component
+ * Construct an archetype with a particular signature. Each component gets a column inside every chunk
+ * Allocate chunks from ChunkManager when full, return them when empty
  * Get archetype signature
  * Get the number of entities that belongs in this archetype
  * Add entity to archetype
+ * Reserve room for a burst of entities
  * Remove entity from archetype
- * Copy component data from archetype to another archetype
+ * Move component data from archetype to another archetype
+ * Copy one entity's components into many rows, a chunk at a time
+ * Map the columns shared with another archetype by merging the sorted component indices, cached on the transition edges
+ * Cache the column maps of moves that don't follow an edge, like shared value changes and batched adds
+ * Relocate trivially copyable components with memcpy instead of their move constructor
+ * Move, copy and write components stored field by field one field at a time
  * Print out the archetype
  *
  * Usage:
@@ -24,22 +31,104 @@
 #include <Archetype.hpp>
 #include <Entity.hpp>
 #include <iostream>
+#include <cassert>
+#include <cstring>
+#include <algorithm>
 #include "Managers/ArchetypeManager.hpp"
-#include "Managers/HandleManager.hpp"
+#include "Managers/ChunkManager.hpp"
+#include "Managers/EntityManager.hpp"
+
+namespace
+{
+	/**
+	 * @brief Remove one occurrence of an archetype from a list of sources, order isn't kept
+	 */
+	void RemoveSource(std::vector<Archetype*>& sources, Archetype const* source)
+	{
+		auto it{ std::find(std::begin(sources), std::end(sources), source) };
+		if (it == std::end(sources)) return;
+		*it = sources.back();
+		sources.pop_back();
+	}
+}
+
+/**
+ * @brief Compare the components and shared values of two archetypes
+ */
+bool ArchetypeKey::operator==(ArchetypeKey const& rhs) const
+{
+	return signature == rhs.signature && sharedValues == rhs.sharedValues;
+}
+
+/**
+ * @brief Hash of the signature, mixed with the shared values
+ */
+size_t std::hash<ArchetypeKey>::operator()(ArchetypeKey const& key) const noexcept
+{
+	size_t hash{ key.signature.GetHash() };
+	for (auto const& [componentIndex, valueIndex] : key.sharedValues)
+		hash ^= (componentIndex * 0x9E3779B97F4A7C15ull + valueIndex) + (hash << 6) + (hash >> 2);
+	return hash;
+}
 
 /**
- * @brief Constructor. Creates a component vector for each component type
+ * @brief Constructor. Lays out a column for each component type inside a chunk,
+ * and fits as many entities as possible in CHUNK_SIZE bytes.
  */
-Archetype::Archetype(Signature signature) :
-	mSignature{ signature }, mSignatureToComponentArrMap{},
-	mEntityIdToIndexMap{}, mIndexToEntityIdMap{}
+Archetype::Archetype(ArchetypeKey const& key) :
+	mSignature{ key.signature }, mChunkCapacity{ 0 }, mColumns{}, mSharedValues{ key.sharedValues },
+	mComponentIds{}, mComponentToColumn{}, mChunks{}, mEntityIds{}, mAddEdges{}, mRemoveEdges{}
 {
-	Signature mask{1};
-	for (size_t i{}; i < MAX_COMPONENTS; ++i)
+	ComponentManager& cm{ ComponentManager::GetInstance() };
+	size_t entitySize{ 0 };
+	mComponentToColumn.fill(static_cast<uint16_t>(INVALID_COLUMN));
+	mSignature.ForEachIndex([&](size_t componentIndex)
+	{
+		ComponentInfo const& info{ cm.GetComponentInfo(componentIndex) };
+		mComponentToColumn[componentIndex] = static_cast<uint16_t>(mColumns.size());
+		mComponentIds.push_back(componentIndex);
+		mColumns.push_back(ChunkColumn{ &info, 0 });
+		entitySize += info.size;
+	});
+
+	// Every chunk starts with the change version of each column, then an enabled bit per entity
+	size_t versionsSize{ mColumns.size() * sizeof(ChangeVersion) };
+
+	// Start from the ideal capacity and shrink until the enabled bits and the alignment padding fit too
+	mChunkCapacity = entitySize ? (CHUNK_SIZE - versionsSize) / entitySize : CHUNK_SIZE;
+	for (; mChunkCapacity > 0; --mChunkCapacity)
 	{
-		if ((signature & mask) == mask)
-			mSignatureToComponentArrMap.insert({ mask, ComponentArray{} });
-		mask <<= 1;
+		size_t offset{ Chunk::GetHeaderSize(mColumns.size(), mChunkCapacity) };
+		for (ChunkColumn& column : mColumns)
+		{
+			// Tags and shared components all point at the start of the chunk, nothing is stored there
+			if (column.info->size == 0) continue;
+
+			size_t alignment{ column.info->alignment };
+			offset = (offset + alignment - 1) / alignment * alignment;
+			column.offset = offset;
+			offset += column.info->size * mChunkCapacity;
+		}
+		if (offset <= CHUNK_SIZE) break;
+	}
+	assert(mChunkCapacity > 0 && "Components of a single entity don't fit in a chunk.");
+}
+
+/**
+ * @brief Destructor. Destroys the components of every entity left in the archetype
+ * and returns the chunks to ChunkManager.
+ */
+Archetype::~Archetype()
+{
+	ChunkManager& chunkManager{ ChunkManager::GetInstance() };
+	for (Chunk& chunk : mChunks)
+	{
+		for (size_t column{}; column < mColumns.size(); ++column)
+		{
+			for (size_t i{}; i < chunk.mEntityCount; ++i)
+				mColumns[column].info->destroy(chunk.GetComponentAddress(i, column));
+		}
+		chunkManager.FreeChunk(chunk.mData);
 	}
 }
 
@@ -52,138 +141,511 @@ Signature Archetype::GetSignature() const
 	return mSignature;
 }
 
+/**
+ * @brief Get the value index of each shared component of the archetype
+ */
+SharedValues const& Archetype::GetSharedValues() const
+{
+	return mSharedValues;
+}
+
+/**
+ * @brief Get the signature and shared values that identify the archetype
+ */
+ArchetypeKey Archetype::GetKey() const
+{
+	return ArchetypeKey{ mSignature, mSharedValues };
+}
+
+/**
+ * @brief Get the indices of the archetype's components, in ascending order. Column i holds component i of this list.
+ */
+std::vector<size_t> const& Archetype::GetComponentIds() const
+{
+	return mComponentIds;
+}
+
 /**
  * @brief Get the number of entities that belong in this archetype
  * @return Number of entities
  */
 size_t Archetype::GetEntityCount() const
 {
-	return mEntityIdToIndexMap.size();
+	return mEntityIds.size();
 }
 
 /**
- * @brief Adds an entity to Archetype
+ * @brief Adds an entity to Archetype. The components of the new row are not constructed yet,
+ * every column has to be filled with EmplaceComponent or MoveComponents.
  * @param entityId Entity member id
+ * @return Row of the entity
  */
-void Archetype::AddEntity(EntityId entityId)
+size_t Archetype::AddEntity(EntityId entityId)
 {
-	size_t index{ mEntityIdToIndexMap.size() };
-	mEntityIdToIndexMap[entityId] = index;
-	mIndexToEntityIdMap[index] = entityId;
-	for (auto& pair : mSignatureToComponentArrMap)
-		pair.second.resize(index + 1);
+	size_t row{ mEntityIds.size() };
+	mEntityIds.push_back(entityId);
+
+	// Last chunk is full
+	if (row % mChunkCapacity == 0)
+		mChunks.emplace_back(this, mColumns.data(), mColumns.size(), mChunkCapacity, row, ChunkManager::GetInstance().AllocateChunk());
+	mChunks.back().InsertRow(row % mChunkCapacity);
+	++mChunks.back().mEntityCount;
+	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
+	mChunks.back().MarkAllChanged(am.GetVersion());
+	am.AdvanceStructureVersion();
+	return row;
 }
 
 /**
- * @brief Removes an entity from Archetype
- * @param entityId Entity member id
+ * @brief Make room for more entities so that adding them doesn't reallocate
+ * @param count Number of entities that will be added
  */
-void Archetype::RemoveEntity(EntityId entityId)
+void Archetype::Reserve(size_t count)
 {
-	size_t entityCount{ mEntityIdToIndexMap.size() };
+	size_t entityCount{ mEntityIds.size() + count };
+	mEntityIds.reserve(entityCount);
+	mChunks.reserve((entityCount + mChunkCapacity - 1) / mChunkCapacity);
+}
 
-	// If removing the last entity, just destroy the Archetype.
-	if (entityCount - 1 <= 0)
+/**
+ * @brief Removes an entity from Archetype. The last entity fills the hole
+ * and its EntityRecord is updated. An archetype left empty is kept for reuse
+ * until ArchetypeManager::CollectEmptyArchetypes reclaims it.
+ * @param row Row of the entity
+ */
+void Archetype::RemoveEntity(size_t row)
+{
+	size_t entityCount{ mEntityIds.size() };
+	if (row >= entityCount)
 	{
-		ArchetypeManager::GetInstance().DestroyArchetype(mSignature);
+		std::cout << __FUNCTION__ << "() Row " << row << " not found in Archetype.\n";
 		return;
 	}
 
-	auto removedIndexIt{ mEntityIdToIndexMap.find(entityId) };
-	if (removedIndexIt == std::end(mEntityIdToIndexMap))
+	size_t removedIndex{ row };
+	size_t lastIndex{ entityCount - 1 };
+
+	// Actually removing the entity components, the last entity fills the hole
+	for (size_t column{}; column < mColumns.size(); ++column)
 	{
-		std::cout << __FUNCTION__ << "() Entity not found in Archetype.\n";
-		return;
+		ComponentInfo const& info{ *mColumns[column].info };
+		void* removed{ GetComponentAddress(removedIndex, column) };
+		info.destroy(removed);
+		if (removedIndex == lastIndex) continue;
+
+		void* last{ GetComponentAddress(lastIndex, column) };
+		if (info.fieldSize)
+		{
+			size_t stride{ info.fieldSize * mChunkCapacity };
+			CopyFields(info, removed, stride, last, stride);
+			continue;
+		}
+		if (info.isTriviallyCopyable)
+		{
+			std::memcpy(removed, last, info.size);
+			continue;
+		}
+		info.moveConstruct(removed, last);
+		info.destroy(last);
 	}
 
-	size_t lastIndex{ entityCount - 1 };
-	auto lastEntityIdIt{ mIndexToEntityIdMap.find(lastIndex) };
-	if (lastEntityIdIt == std::end(mIndexToEntityIdMap))
+	// Both chunks lost or replaced a row
+	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
+	ChangeVersion version{ am.GetVersion() };
+	GetChunk(removedIndex).MarkAllChanged(version);
+	mChunks.back().MarkAllChanged(version);
+	am.AdvanceStructureVersion();
+
+	// The last entity keeps its enabled state in the removed row
+	Chunk& lastChunk{ mChunks.back() };
+	size_t lastChunkRow{ lastIndex % mChunkCapacity };
+	GetChunk(removedIndex).SetEnabled(removedIndex % mChunkCapacity, lastChunk.IsEnabled(lastChunkRow));
+	lastChunk.EraseRow(lastChunkRow);
+
+	// Give the last chunk back once it is empty
+	if (--lastChunk.mEntityCount == 0)
 	{
-		std::cout << __FUNCTION__ << "() Last entity not found in Archetype.\n";
-		return;
+		ChunkManager::GetInstance().FreeChunk(lastChunk.mData);
+		mChunks.pop_back();
 	}
 
-	size_t removedIndex{ removedIndexIt->second };
-	EntityId lastEntityId{ lastEntityIdIt->second };
+	mEntityIds[removedIndex] = mEntityIds[lastIndex];
+	mEntityIds.pop_back();
+	if (removedIndex == lastIndex) return;
 
-	mEntityIdToIndexMap[lastEntityId] = removedIndex;
-	mIndexToEntityIdMap[removedIndex] = lastEntityId;
+	// The last entity now lives in the removed row
+	EntityManager::GetInstance().GetRecord(mEntityIds[removedIndex]).row = removedIndex;
+}
 
-	mEntityIdToIndexMap.erase(entityId);
-	mIndexToEntityIdMap.erase(lastIndex);
+/**
+ * @brief Get the entity stored in a row
+ * @param[in] row Row of the entity
+ * @return Entity member id
+ */
+EntityId Archetype::GetEntityId(size_t row) const
+{
+	return mEntityIds[row];
+}
 
-	// Actually removing the entity components
-	for (auto& pair : mSignatureToComponentArrMap)
+/**
+ * @brief Get the entity of every row, in row order
+ * @return Pointer to the entity of row 0, valid for GetEntityCount() entities until the next structural change
+ */
+EntityId const* Archetype::GetEntityIds() const
+{
+	return mEntityIds.data();
+}
+
+/**
+ * @brief Check if an entity is enabled
+ * @param[in] row Row of the entity
+ */
+bool Archetype::IsEnabled(size_t row)
+{
+	return GetChunk(row).IsEnabled(row % mChunkCapacity);
+}
+
+/**
+ * @brief Enable or disable an entity. The entity stays in its row, so references to it stay valid.
+ * Every column of its chunk is stamped, readers that skip unchanged chunks see it appear or disappear.
+ * @param row Row of the entity
+ * @param isEnabled New state of the entity
+ */
+void Archetype::SetEnabled(size_t row, bool isEnabled)
+{
+	Chunk& chunk{ GetChunk(row) };
+	size_t chunkRow{ row % mChunkCapacity };
+	if (chunk.IsEnabled(chunkRow) == isEnabled) return;
+
+	chunk.SetEnabled(chunkRow, isEnabled);
+	chunk.MarkAllChanged(ArchetypeManager::GetInstance().GetVersion());
+}
+
+/**
+ * @brief Move component data from an archetype to another. The entity keeps its enabled state.
+ * Trivially copyable components are relocated with memcpy, the others with their move constructor.
+ * @param row Row of the entity in this archetype
+ * @param to Pointer to the archetype
+ * @param toRow Row of the entity in "to" archetype
+ * @param columnMap Columns shared by both archetypes, from MapColumns
+ */
+void Archetype::MoveComponents(size_t row, Archetype* to, size_t toRow, ColumnMap const& columnMap)
+{
+	// Both rows stay in the same chunk, so resolve them once
+	Chunk& fromChunk{ GetChunk(row) };
+	Chunk& toChunk{ to->GetChunk(toRow) };
+	size_t fromChunkRow{ row % mChunkCapacity };
+	size_t toChunkRow{ toRow % to->mChunkCapacity };
+	for (auto const& [fromColumn, toColumn] : columnMap)
 	{
-		pair.second[removedIndex] = std::move(pair.second[lastIndex]);
-		pair.second.pop_back();
+		ComponentInfo const& info{ *mColumns[fromColumn].info };
+		void* destination{ toChunk.GetComponentAddress(toChunkRow, toColumn) };
+		void* source{ fromChunk.GetComponentAddress(fromChunkRow, fromColumn) };
+
+		// Trivially copyable components are relocated with memcpy, their destructor does nothing
+		if (info.fieldSize)
+			CopyFields(info, destination, info.fieldSize * to->mChunkCapacity, source, info.fieldSize * mChunkCapacity);
+		else if (info.isTriviallyCopyable)
+			std::memcpy(destination, source, info.size);
+		else
+			info.moveConstruct(destination, source);
 	}
+	toChunk.SetEnabled(toChunkRow, fromChunk.IsEnabled(fromChunkRow));
 }
 
 /**
- * @brief Copy component data from an archetype to another
- * @param entityId Entity member id
+ * @brief Copy the components of an entity into rows of another archetype, one column at a time.
+ * Trivially copyable columns are copied with memcpy. Components deriving from IComponent are given their new owner.
+ * @param row Row of the entity to copy in this archetype
  * @param to Pointer to the archetype
+ * @param toRow First row of "to" to copy into, its components are not constructed yet
+ * @param count Number of rows to copy into, starting at toRow
+ * @param columnMap Columns shared by both archetypes, from MapColumns
  */
-void Archetype::MoveComponents(EntityId entityId, Archetype* to)
+void Archetype::CopyComponents(size_t row, Archetype* to, size_t toRow, size_t count, ColumnMap const& columnMap)
 {
-	// Entity must exist in both Archetypes first so that we can copy
-	auto fromIndexIt{ mEntityIdToIndexMap.find(entityId) };
-	if (fromIndexIt == std::end(mEntityIdToIndexMap))
+	Chunk& fromChunk{ GetChunk(row) };
+	size_t fromChunkRow{ row % mChunkCapacity };
+	size_t endRow{ toRow + count };
+	for (auto const& [fromColumn, toColumn] : columnMap)
 	{
-		std::cout << "Entity doesn't exist in \"From\" archetype.\n";
-		return;
+		ComponentInfo const& info{ *mColumns[fromColumn].info };
+		void const* source{ fromChunk.GetComponentAddress(fromChunkRow, fromColumn) };
+		size_t rowSize{ info.fieldSize ? info.fieldSize : info.size };
+
+		// Rows of a chunk are next to each other in the column, so copy a chunk at a time
+		for (size_t first{ toRow }; first < endRow;)
+		{
+			Chunk& toChunk{ to->GetChunk(first) };
+			size_t toChunkRow{ first % to->mChunkCapacity };
+			size_t runCount{ std::min(endRow - first, to->mChunkCapacity - toChunkRow) };
+			std::byte* destination{ static_cast<std::byte*>(toChunk.GetComponentAddress(toChunkRow, toColumn)) };
+			for (size_t i{}; i < runCount; ++i, destination += rowSize)
+			{
+				if (info.fieldSize)
+					CopyFields(info, destination, info.fieldSize * to->mChunkCapacity, source, info.fieldSize * mChunkCapacity);
+				else if (info.isTriviallyCopyable)
+					std::memcpy(destination, source, info.size);
+				else
+					info.copyConstruct(destination, source);
+				if (info.setOwner)
+					info.setOwner(destination, to->mEntityIds[first + i]);
+			}
+			first += runCount;
+		}
 	}
+}
+
+/**
+ * @brief Copy a component stored field by field, one field at a time
+ * @param info Information of the component's column
+ * @param destination Address of the first field to write
+ * @param destinationStride Bytes between two fields of the destination
+ * @param source Address of the first field to read
+ * @param sourceStride Bytes between two fields of the source, sizeof the field for a whole component
+ */
+void Archetype::CopyFields(ComponentInfo const& info, void* destination, size_t destinationStride, void const* source, size_t sourceStride)
+{
+	std::byte* to{ static_cast<std::byte*>(destination) };
+	std::byte const* from{ static_cast<std::byte const*>(source) };
+	for (size_t field{}; field < info.size / info.fieldSize; ++field, to += destinationStride, from += sourceStride)
+		std::memcpy(to, from, info.fieldSize);
+}
 
-	auto toIndexIt{ to->mEntityIdToIndexMap.find(entityId) };
-	if (toIndexIt == std::end(to->mEntityIdToIndexMap))
+/**
+ * @brief Pair up the columns this archetype shares with another
+ * @param[in] to Archetype the components will be moved to
+ * @return Pairs of ("From" column, "To" column)
+ */
+ColumnMap Archetype::MapColumns(Archetype const& to) const
+{
+	ColumnMap columnMap;
+	columnMap.reserve(mColumns.size());
+
+	// Both lists are sorted and columns follow the same order, so walk them side by side
+	size_t fromColumn{ 0 };
+	size_t toColumn{ 0 };
+	while (fromColumn < mComponentIds.size() && toColumn < to.mComponentIds.size())
 	{
-		std::cout << "Entity doesn't exist in \"To\" archetype.\n";
-		return;
+		size_t fromId{ mComponentIds[fromColumn] };
+		size_t toId{ to.mComponentIds[toColumn] };
+		if (fromId == toId)
+		{
+			// Tags and shared components have nothing to move
+			if (mColumns[fromColumn].info->size > 0)
+				columnMap.emplace_back(fromColumn, toColumn);
+			++fromColumn;
+			++toColumn;
+		}
+		else if (fromId < toId)
+			++fromColumn;
+		else
+			++toColumn;
 	}
+	return columnMap;
+}
 
-	// Looping "From" Archetype
-	for (auto& pair : mSignatureToComponentArrMap)
+/**
+ * @brief Get the columns this archetype shares with another, mapped on first use and then cached.
+ * For moves that don't follow an add or remove edge.
+ * @param[in] to Archetype the components will be moved to
+ * @return Pairs of ("From" column, "To" column), valid until either archetype is destroyed
+ */
+ColumnMap const& Archetype::GetColumnMap(Archetype& to)
+{
+	auto it{ mColumnMaps.find(&to) };
+	if (it == std::end(mColumnMaps))
 	{
-		// Skip if "to" archetype doesn't have a particular component array.
-		auto componentIt{ to->mSignatureToComponentArrMap.find(pair.first) };
-		if (componentIt == std::end(to->mSignatureToComponentArrMap)) continue;
-		componentIt->second[toIndexIt->second] = std::move(pair.second[fromIndexIt->second]);
+		it = mColumnMaps.emplace(&to, MapColumns(to)).first;
+		to.mColumnMapSources.push_back(this);
 	}
+	return it->second;
 }
 
-ComponentArray& Archetype::GetComponentArray(Signature componentSignature)
+/**
+ * @brief Forget the cached column maps to and from this archetype, when it is destroyed.
+ * Only the archetypes that cached a map to this one are told.
+ */
+void Archetype::UnlinkColumnMaps()
 {
-	return mSignatureToComponentArrMap[componentSignature];
+	for (Archetype* source : mColumnMapSources)
+		source->mColumnMaps.erase(this);
+	mColumnMapSources.clear();
+
+	for (auto const& [to, columnMap] : mColumnMaps)
+		RemoveSource(to->mColumnMapSources, this);
+	mColumnMaps.clear();
 }
 
-size_t Archetype::GetIndexFromEntityId(EntityId entityId)
+/**
+ * @brief Get the cached edge for adding a component. Edge is empty until ArchetypeManager links it.
+ * @param[in] componentIndex Index of the component
+ */
+ArchetypeEdge& Archetype::GetAddEdge(size_t componentIndex)
 {
-	auto it{ mEntityIdToIndexMap.find(entityId) };
-	if (it == std::end(mEntityIdToIndexMap)) return static_cast<size_t>(-1);
-	return it->second;
+	return mAddEdges[componentIndex];
+}
+
+/**
+ * @brief Get the cached edge for removing a component. Edge is empty until ArchetypeManager links it.
+ * @param[in] componentIndex Index of the component
+ */
+ArchetypeEdge& Archetype::GetRemoveEdge(size_t componentIndex)
+{
+	return mRemoveEdges[componentIndex];
+}
+
+/**
+ * @brief Get the edges that were linked for adding components, by component index
+ */
+std::unordered_map<size_t, ArchetypeEdge> const& Archetype::GetAddEdges() const
+{
+	return mAddEdges;
+}
+
+/**
+ * @brief Get the edges that were linked for removing components, by component index
+ */
+std::unordered_map<size_t, ArchetypeEdge> const& Archetype::GetRemoveEdges() const
+{
+	return mRemoveEdges;
+}
+
+/**
+ * @brief Point one of this archetype's edges at another archetype and map their columns.
+ * The other archetype remembers the edge, so it can be unlinked when either of them is destroyed.
+ * @param edge Edge owned by this archetype, from GetAddEdge or GetRemoveEdge
+ * @param to Archetype the edge leads to
+ */
+void Archetype::LinkEdge(ArchetypeEdge& edge, Archetype* to)
+{
+	if (edge.to)
+		RemoveSource(edge.to->mEdgeSources, this);
+	edge.to = to;
+	edge.columnMap = MapColumns(*to);
+	to->mEdgeSources.push_back(this);
+}
+
+/**
+ * @brief Forget the edges to and from this archetype, when it is destroyed.
+ * Only the archetypes with an edge to this one are told.
+ */
+void Archetype::UnlinkEdges()
+{
+	// Several archetypes can lead to this one through the same component, e.g. one per value of a removed shared component
+	for (Archetype* source : mEdgeSources)
+	{
+		for (auto* edges : { &source->mAddEdges, &source->mRemoveEdges })
+		{
+			for (auto it{ std::begin(*edges) }; it != std::end(*edges);)
+			{
+				if (it->second.to == this)
+					it = edges->erase(it);
+				else
+					++it;
+			}
+		}
+	}
+	mEdgeSources.clear();
+
+	for (auto* edges : { &mAddEdges, &mRemoveEdges })
+	{
+		for (auto const& [componentIndex, edge] : *edges)
+		{
+			if (edge.to)
+				RemoveSource(edge.to->mEdgeSources, this);
+		}
+		edges->clear();
+	}
+}
+
+/**
+ * @brief Get the chunks of the archetype. Only the last chunk may be partially filled.
+ * @return Reference to the vector of chunks
+ */
+std::vector<Chunk>& Archetype::GetChunks()
+{
+	return mChunks;
+}
+
+/**
+ * @brief Get the number of entities a single chunk can hold
+ */
+size_t Archetype::GetChunkCapacity() const
+{
+	return mChunkCapacity;
 }
 
 /**
- * @brief Displays the component vectors
+ * @brief Get the index of a component's column
+ * @param[in] componentIndex Index of the component, from ComponentManager::GetComponentIndex
+ * @return Index of the column, or INVALID_COLUMN if the archetype doesn't have the component
+ */
+size_t Archetype::GetColumnIndex(size_t componentIndex) const
+{
+	return mComponentToColumn[componentIndex];
+}
+
+/**
+ * @brief Get the type-erased information of a column
+ * @param[in] column Index of the column
+ */
+ComponentInfo const& Archetype::GetColumnInfo(size_t column) const
+{
+	return *mColumns[column].info;
+}
+
+/**
+ * @brief Get the address of a component
+ * @param[in] index Index of the entity in the archetype
+ * @param[in] column Index of the column
+ */
+void* Archetype::GetComponentAddress(size_t index, size_t column)
+{
+	return GetChunk(index).GetComponentAddress(index % mChunkCapacity, column);
+}
+
+/**
+ * @brief Get the chunk of an entity
+ * @param[in] index Index of the entity in the archetype
+ */
+Chunk& Archetype::GetChunk(size_t index)
+{
+	return mChunks[index / mChunkCapacity];
+}
+
+/**
+ * @brief Stamp the column of an entity's chunk with the current version
+ * @param[in] index Index of the entity in the archetype
+ * @param[in] column Index of the column
+ */
+void Archetype::MarkChanged(size_t index, size_t column)
+{
+	GetChunk(index).MarkChanged(column, ArchetypeManager::GetInstance().GetVersion());
+}
+
+/**
+ * @brief Displays the chunks of the archetype
  */
 void Archetype::PrintArchetype() const
 {
-	std::cout << "\n[ Archetype " << mSignature << " ]\n";
+	std::cout << "\n[ Archetype " << mSignature << " ] " << mChunkCapacity << " entities per chunk";
+	for (auto const& [componentIndex, valueIndex] : mSharedValues)
+		std::cout << ", shared " << componentIndex << " = value " << valueIndex;
+	std::cout << '\n';
 	int count{0};
-	for (auto const& pair : mSignatureToComponentArrMap)
+	for (Chunk const& chunk : mChunks)
 	{
-		for (size_t i{}; i < pair.second.size(); ++i)
+		for (size_t i{}; i < chunk.mEntityCount; ++i)
 		{
 			std::cout << " _";
 		}
 		std::cout << "\n|";
-		for (size_t i{}; i < pair.second.size(); ++i)
+		for (size_t i{}; i < chunk.mEntityCount; ++i)
 		{
 			std::cout << "_|";
 		}
-		std::cout << " Component " << ++count << "\n";
+		std::cout << " Chunk " << ++count << "\n";
 	}
 	std::cout << '\n';
 }
@@ -0,0 +1,231 @@
+/*************************************************************//**
+ * @file   Chunk.cpp
+ * @brief  Function definitions of Chunk, a fixed-size block of components.
+ *
+ * Key features:
+ * Get the owning archetype
+ * Get the number of entities in the chunk
+ * Get the address of a component
+ * Enable and disable entities with a bit per row, find runs of enabled entities a word at a time
+ *
+ * Usage:
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include "Chunk.hpp"
+#include "Archetype.hpp"
+#include <algorithm>
+
+namespace
+{
+	constexpr size_t BITS_PER_WORD{ 64 };
+
+	/**
+	 * @brief Get the offset of the enabled bits, after the change versions
+	 */
+	size_t GetEnabledBitsOffset(size_t columnCount)
+	{
+		size_t offset{ columnCount * sizeof(ChangeVersion) };
+		return (offset + alignof(uint64_t) - 1) / alignof(uint64_t) * alignof(uint64_t);
+	}
+}
+
+/**
+ * @brief Constructor
+ * @param[in] archetype Archetype that owns the chunk
+ * @param[in] columns Column layout of the archetype
+ * @param[in] columnCount Number of columns of the archetype
+ * @param[in] capacity Number of entities the chunk can hold
+ * @param[in] firstRow Row of the chunk's first entity in the archetype
+ * @param[in] data Memory from ChunkManager, starting with a header of GetHeaderSize(columnCount, capacity) bytes
+ */
+Chunk::Chunk(Archetype* archetype, ChunkColumn const* columns, size_t columnCount, size_t capacity, size_t firstRow, std::byte* data) :
+	mArchetype{ archetype }, mColumns{ columns }, mColumnCount{ columnCount }, mCapacity{ capacity }, mFirstRow{ firstRow },
+	mData{ data }, mEntityCount{ 0 }, mChangeVersions{ reinterpret_cast<ChangeVersion*>(data) },
+	mEnabledBits{ reinterpret_cast<uint64_t*>(data + GetEnabledBitsOffset(columnCount)) }, mDisabledCount{ 0 }
+{
+	std::fill_n(mChangeVersions, mColumnCount, ChangeVersion{ 0 });
+	std::fill_n(mEnabledBits, (mCapacity + BITS_PER_WORD - 1) / BITS_PER_WORD, uint64_t{ 0 });
+}
+
+/**
+ * @brief Get the bytes at the start of a chunk used by the change versions and the enabled bits
+ * @param[in] columnCount Number of columns of the archetype
+ * @param[in] capacity Number of entities the chunk can hold
+ */
+size_t Chunk::GetHeaderSize(size_t columnCount, size_t capacity)
+{
+	return GetEnabledBitsOffset(columnCount) + (capacity + BITS_PER_WORD - 1) / BITS_PER_WORD * sizeof(uint64_t);
+}
+
+/**
+ * @brief Get the archetype that owns the chunk
+ */
+Archetype* Chunk::GetArchetype() const
+{
+	return mArchetype;
+}
+
+/**
+ * @brief Get the number of entities the chunk can hold
+ */
+size_t Chunk::GetCapacity() const
+{
+	return mCapacity;
+}
+
+/**
+ * @brief Get the entity of every row of the chunk, entity i owns the components at index i of the arrays
+ * @return Pointer to the entity of the first row, valid for GetEntityCount() entities
+ */
+EntityId const* Chunk::GetEntityIds() const
+{
+	return mArchetype->GetEntityIds() + mFirstRow;
+}
+
+/**
+ * @brief Get the number of entities stored in the chunk
+ */
+size_t Chunk::GetEntityCount() const
+{
+	return mEntityCount;
+}
+
+/**
+ * @brief Get the address of a component. The component may not be constructed yet.
+ * @param[in] index Index of the entity in the chunk
+ * @param[in] column Index of the column in the archetype
+ */
+void* Chunk::GetComponentAddress(size_t index, size_t column)
+{
+	// Components stored field by field start with their first field
+	ChunkColumn const& chunkColumn{ mColumns[column] };
+	ComponentInfo const& info{ *chunkColumn.info };
+	return mData + chunkColumn.offset + index * (info.fieldSize ? info.fieldSize : info.size);
+}
+
+/**
+ * @brief Get the bytes between two fields of the same component, for columns stored field by field
+ * @param[in] column Index of the column in the archetype
+ * @return Stride of the field arrays, 0 if the column stores whole components
+ */
+size_t Chunk::GetFieldStride(size_t column) const
+{
+	return mColumns[column].info->fieldSize * mCapacity;
+}
+
+/**
+ * @brief Get the version of the last write to a column
+ * @param[in] column Index of the column in the archetype
+ */
+ChangeVersion Chunk::GetChangeVersion(size_t column) const
+{
+	return mChangeVersions[column];
+}
+
+/**
+ * @brief Stamp a column as written
+ * @param[in] column Index of the column in the archetype
+ * @param[in] version Version of the writer, from ArchetypeManager::GetVersion
+ */
+void Chunk::MarkChanged(size_t column, ChangeVersion version)
+{
+	mChangeVersions[column] = version;
+}
+
+/**
+ * @brief Stamp every column as written, for rows that were added, removed or moved
+ * @param[in] version Version of the writer, from ArchetypeManager::GetVersion
+ */
+void Chunk::MarkAllChanged(ChangeVersion version)
+{
+	std::fill_n(mChangeVersions, mColumnCount, version);
+}
+
+/**
+ * @brief Check if an entity is enabled
+ * @param[in] index Index of the entity in the chunk
+ */
+bool Chunk::IsEnabled(size_t index) const
+{
+	return (mEnabledBits[index / BITS_PER_WORD] >> index % BITS_PER_WORD) & 1;
+}
+
+/**
+ * @brief Get the number of enabled entities in the chunk
+ */
+size_t Chunk::GetEnabledCount() const
+{
+	return mEntityCount - mDisabledCount;
+}
+
+/**
+ * @brief Enable or disable an entity. Use Archetype::SetEnabled, which also stamps the chunk.
+ * @param[in] index Index of the entity in the chunk
+ * @param[in] isEnabled New state of the entity
+ */
+void Chunk::SetEnabled(size_t index, bool isEnabled)
+{
+	if (IsEnabled(index) == isEnabled) return;
+
+	uint64_t bit{ uint64_t{ 1 } << index % BITS_PER_WORD };
+	if (isEnabled)
+	{
+		mEnabledBits[index / BITS_PER_WORD] |= bit;
+		--mDisabledCount;
+	}
+	else
+	{
+		mEnabledBits[index / BITS_PER_WORD] &= ~bit;
+		++mDisabledCount;
+	}
+}
+
+/**
+ * @brief Enable the bit of a row that was just added to the chunk
+ * @param[in] index Index of the entity in the chunk
+ */
+void Chunk::InsertRow(size_t index)
+{
+	mEnabledBits[index / BITS_PER_WORD] |= uint64_t{ 1 } << index % BITS_PER_WORD;
+}
+
+/**
+ * @brief Clear the bit of the last row before it leaves the chunk, so runs never go past the entity count
+ * @param[in] index Index of the entity in the chunk
+ */
+void Chunk::EraseRow(size_t index)
+{
+	if (!IsEnabled(index)) --mDisabledCount;
+	mEnabledBits[index / BITS_PER_WORD] &= ~(uint64_t{ 1 } << index % BITS_PER_WORD);
+}
+
+/**
+ * @brief Find the next entity with a given state, checking 64 entities per step
+ * @param[in] index Index to start from
+ * @param[in] isEnabled State to look for
+ * @return Index of the entity, or GetEntityCount() if there is none
+ */
+size_t Chunk::FindNext(size_t index, bool isEnabled) const
+{
+	if (index >= mEntityCount) return mEntityCount;
+
+	// Flip the words when looking for disabled entities, so the search is always for a set bit
+	uint64_t flip{ isEnabled ? uint64_t{ 0 } : ~uint64_t{ 0 } };
+	size_t word{ index / BITS_PER_WORD };
+	size_t wordCount{ (mEntityCount + BITS_PER_WORD - 1) / BITS_PER_WORD };
+	uint64_t bits{ (mEnabledBits[word] ^ flip) & (~uint64_t{ 0 } << index % BITS_PER_WORD) };
+
+	// Words of 64 rows in the wrong state are skipped with a single compare
+	while (bits == 0)
+	{
+		if (++word == wordCount) return mEntityCount;
+		bits = mEnabledBits[word] ^ flip;
+	}
+	return std::min(word * BITS_PER_WORD + CountTrailingZeros(bits), mEntityCount);
+}
@@ -0,0 +1,130 @@
+/*************************************************************//**
+ * @file   CommandBuffer.cpp
+ * @brief  Function definitions of CommandBuffer.
+ *
+ * Key features:
+ * Record entity destruction
+ * Record enabling and disabling entities
+ * Play back every recorded command in batches
+ *
+ * Usage:
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include <algorithm>
+#include "CommandBuffer.hpp"
+#include "Managers/EntityManager.hpp"
+
+/**
+ * @brief Constructor
+ */
+CommandBuffer::CommandBuffer() :
+	mTypeToComponentCommandsMap{}, mTypeToSpawnCommandsMap{},
+	mStructuralCommands{}, mSetCommands{}, mEnableCommands{}, mDestroyedEntities{}
+{}
+
+CommandBuffer::~CommandBuffer() = default;
+
+/**
+ * @brief Record the destruction of an entity
+ * @param entityId Entity member id
+ */
+void CommandBuffer::DestroyEntity(EntityId entityId)
+{
+	mDestroyedEntities.push_back(entityId);
+}
+
+/**
+ * @brief Record enabling or disabling an entity
+ * @param entityId Entity member id
+ * @param isEnabled New state of the entity
+ */
+void CommandBuffer::SetEnabled(EntityId entityId, bool isEnabled)
+{
+	mEnableCommands.emplace_back(entityId, isEnabled);
+}
+
+/**
+ * @brief Check if there is any recorded command
+ */
+bool CommandBuffer::IsEmpty() const
+{
+	for (auto const& pair : mTypeToSpawnCommandsMap)
+		if (!pair.second->IsEmpty()) return false;
+	return mStructuralCommands.empty() && mSetCommands.empty() && mEnableCommands.empty() && mDestroyedEntities.empty();
+}
+
+/**
+ * @brief Apply every recorded command and clear the buffer.
+ * Order: spawns, adds and removes, sets, enables, destroys.
+ */
+void CommandBuffer::Playback()
+{
+	EntityManager& em{ EntityManager::GetInstance() };
+
+	for (auto& pair : mTypeToSpawnCommandsMap)
+		pair.second->Playback(em);
+
+	// Entities leaving the same archetype through the same edge end up next to each other.
+	// Stable, so commands on the same entity and component keep their order.
+	std::stable_sort(std::begin(mStructuralCommands), std::end(mStructuralCommands),
+		[&em](Command const& lhs, Command const& rhs)
+		{
+			Archetype* lhsArchetype{ em.GetRecord(lhs.entityId).archetype };
+			Archetype* rhsArchetype{ em.GetRecord(rhs.entityId).archetype };
+			if (lhsArchetype != rhsArchetype) return std::less<Archetype*>{}(lhsArchetype, rhsArchetype);
+			return lhs.componentIndex < rhs.componentIndex;
+		});
+	for (Command const& command : mStructuralCommands)
+	{
+		if (!em.IsAlive(command.entityId)) continue;
+		Entity& entity{ em.GetEntity(command.entityId) };
+		if (command.type == CommandType::Add)
+			command.commands->Add(em, entity, command.payload);
+		else
+			command.commands->Remove(em, entity);
+	}
+
+	for (Command const& command : mSetCommands)
+	{
+		if (!em.IsAlive(command.entityId)) continue;
+		command.commands->Set(em, em.GetEntity(command.entityId), command.payload);
+	}
+
+	for (auto const& [entityId, isEnabled] : mEnableCommands)
+	{
+		if (!em.IsAlive(entityId)) continue;
+		em.SetEnabled(em.GetEntity(entityId), isEnabled);
+	}
+
+	// Removing the highest rows of an archetype first means the entity filling each hole
+	// is never one that is about to be removed, so every archetype is compacted in one pass
+	mDestroyedEntities.erase(std::remove_if(std::begin(mDestroyedEntities), std::end(mDestroyedEntities),
+		[&em](EntityId entityId) { return !em.IsAlive(entityId); }), std::end(mDestroyedEntities));
+	std::sort(std::begin(mDestroyedEntities), std::end(mDestroyedEntities),
+		[&em](EntityId lhs, EntityId rhs)
+		{
+			EntityRecord const& lhsRecord{ em.GetRecord(lhs) };
+			EntityRecord const& rhsRecord{ em.GetRecord(rhs) };
+			if (lhsRecord.archetype != rhsRecord.archetype)
+				return std::less<Archetype*>{}(lhsRecord.archetype, rhsRecord.archetype);
+			return lhsRecord.row > rhsRecord.row;
+		});
+	for (EntityId entityId : mDestroyedEntities)
+	{
+		if (!em.IsAlive(entityId)) continue;
+		em.DestroyEntity(em.GetEntity(entityId));
+	}
+
+	for (auto& pair : mTypeToComponentCommandsMap)
+		pair.second->Clear();
+	mStructuralCommands.clear();
+	mSetCommands.clear();
+	mEnableCommands.clear();
+	mDestroyedEntities.clear();
+}
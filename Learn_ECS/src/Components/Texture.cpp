@@ -0,0 +1,30 @@
+/*************************************************************//**
+ * @file   Texture.cpp
+ * @brief  Shared component of type Texture of an entity
+ *
+ * Key features:
+ *
+ * Usage:
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include "Components/Texture.hpp"
+
+Texture::Texture(TextureId id, GLint width, GLint height) :
+	mId{ id },
+	mTextureWidth{ width },
+	mTextureHeight{ height }
+{}
+
+/**
+ * @brief Textures are the same if they have the same ID
+ */
+bool Texture::operator==(Texture const& rhs) const
+{
+	return mId == rhs.mId;
+}
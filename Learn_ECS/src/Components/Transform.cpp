@@ -1,5 +0,0 @@
-#include "Components/Transform.hpp"
-
-Transform::Transform(float _x, float _y, float _a, float _w, float _h) :
-	x{ _x }, y{ _y }, a{ _a }, w{ _w }, h{ _h }
-{}
@@ -10,6 +10,7 @@
  * Add Entities to Archetypes
  * Remove Entities from Archetypes
  * Copy components from Archetype to Archetype
+ * Link the add/remove component edges between Archetypes
  *
  * Usage:
  *
@@ -21,11 +22,22 @@
 *****************************************************************/
 
 #include <Managers/ArchetypeManager.hpp>
+#include <Managers/ChunkManager.hpp>
 #include <iostream>
+#include <algorithm>
 
+thread_local ChangeVersion ArchetypeManager::threadVersion{ 0 };
+
+/**
+ * @brief Constructor. Versions start at 1 so that every column counts as changed for a system that never ran.
+ */
 ArchetypeManager::ArchetypeManager() :
-	mSignatureToArchetypeMap{}
-{}
+	mVersion{ 1 }, mStructureVersion{ 1 }, mKeyToArchetypeMap{}, mRootEdges{}, mTypeToQueryMap{},
+	mCollectableArchetypes{}, mStats{}
+{
+	// Archetypes return their chunks when destroyed, so the pool has to outlive this singleton
+	ChunkManager::GetInstance();
+}
 
 /**
  * @brief Get the singleton instance
@@ -39,43 +51,319 @@ ArchetypeManager& ArchetypeManager::GetInstance()
 /**
  * @brief Creates an archetype with a given signature. Doesn't do anything if archetype exists
  * @param signature Signature of the Archetype to create
+ * @param sharedValues Values of the shared components in the signature, sorted by component index
  * @return Pointer to the created archetype, or nullptr.
  */
-Archetype* ArchetypeManager::CreateArchetype(Signature signature)
+Archetype* ArchetypeManager::CreateArchetype(Signature signature, SharedValues const& sharedValues)
 {
-	mSignatureToArchetypeMap.insert({ signature, Archetype{ signature } });
-	auto it{ mSignatureToArchetypeMap.find(signature) };
-	if (it == std::end(mSignatureToArchetypeMap)) return nullptr;
+	// Archetypes can't be moved, so construct it in place
+	ArchetypeKey key{ signature, sharedValues };
+	auto [it, inserted] { mKeyToArchetypeMap.try_emplace(key, key) };
+	if (inserted)
+	{
+		++mStats.createdCount;
+		for (auto& pair : mTypeToQueryMap)
+			pair.second->Match(&it->second);
+	}
 	return &it->second;
 }
 
 /**
  * @brief Destroy an archetype
  * @param signature Signature of the Archetype
+ * @param sharedValues Values of the shared components in the signature, sorted by component index
+ */
+void ArchetypeManager::DestroyArchetype(Signature signature, SharedValues const& sharedValues)
+{
+	ArchetypeKey key{ signature, sharedValues };
+	auto it{ mKeyToArchetypeMap.find(key) };
+	if (it == std::end(mKeyToArchetypeMap)) return;
+	Archetype* archetype{ &it->second };
+	for (auto& pair : mTypeToQueryMap)
+		pair.second->Unmatch(archetype);
+
+	// Edges and column maps are unlinked through the archetypes that point at this one
+	archetype->UnlinkEdges();
+	archetype->UnlinkColumnMaps();
+
+	std::vector<size_t> const& componentIds{ archetype->GetComponentIds() };
+	if (componentIds.size() == 1)
+	{
+		auto rootIt{ mRootEdges.find(componentIds.front()) };
+		if (rootIt != std::end(mRootEdges) && rootIt->second.to == archetype)
+			mRootEdges.erase(rootIt);
+	}
+	mKeyToArchetypeMap.erase(it);
+	mCollectableArchetypes.erase(key);
+	++mStats.destroyedCount;
+}
+
+/**
+ * @brief Destroy archetypes that were already empty on the previous pass, so that archetypes
+ * emptied and refilled between two passes are kept. Call it every few seconds, not every frame.
+ * @param budget Maximum number of archetypes to destroy, the rest waits for the next pass
+ * @return Number of archetypes destroyed
+ */
+size_t ArchetypeManager::CollectEmptyArchetypes(size_t budget)
+{
+	std::vector<ArchetypeKey> collected;
+	std::unordered_set<ArchetypeKey> emptyArchetypes;
+	for (auto const& [key, archetype] : mKeyToArchetypeMap)
+	{
+		if (archetype.GetEntityCount() > 0) continue;
+
+		bool wasEmpty{ mCollectableArchetypes.count(key) > 0 };
+		if (wasEmpty && collected.size() < budget)
+			collected.push_back(key);
+		else
+			emptyArchetypes.insert(key);
+	}
+
+	mCollectableArchetypes = std::move(emptyArchetypes);
+	for (ArchetypeKey const& key : collected)
+		DestroyArchetype(key.signature, key.sharedValues);
+	mStats.lastCollectedCount = collected.size();
+	return collected.size();
+}
+
+/**
+ * @brief Get the archetype counters
+ */
+ArchetypeStats ArchetypeManager::GetStats() const
+{
+	ArchetypeStats stats{ mStats };
+	stats.archetypeCount = mKeyToArchetypeMap.size();
+	stats.emptyArchetypeCount = 0;
+	for (auto const& pair : mKeyToArchetypeMap)
+		stats.emptyArchetypeCount += pair.second.GetEntityCount() == 0;
+	return stats;
+}
+
+/**
+ * @brief Get the edge for adding a component, creating the archetype it leads to on first use.
+ * @param from Archetype of the entity, or nullptr if the entity has no components
+ * @param componentIndex Index of the component to add
+ * @return Reference to the edge, owned by "from"
  */
-void ArchetypeManager::DestroyArchetype(Signature signature)
+ArchetypeEdge& ArchetypeManager::GetAddEdge(Archetype* from, size_t componentIndex)
 {
-	mSignatureToArchetypeMap.erase(signature);
+	ArchetypeEdge& edge{ from ? from->GetAddEdge(componentIndex) : mRootEdges[componentIndex] };
+	if (edge.to) return edge;
+
+	// Shared values are kept, the new component isn't a shared one
+	Signature signature{ from ? from->GetSignature() : Signature{} };
+	SharedValues sharedValues{ from ? from->GetSharedValues() : SharedValues{} };
+	Archetype* to{ CreateArchetype(signature | Signature{}.set(componentIndex), sharedValues) };
+	if (!from)
+	{
+		edge.to = to;
+		return edge;
+	}
+
+	from->LinkEdge(edge, to);
+	to->LinkEdge(to->GetRemoveEdge(componentIndex), from);
+	return edge;
+}
+
+/**
+ * @brief Get the edge for removing a component, creating the archetype it leads to on first use.
+ * @param from Archetype of the entity
+ * @param componentIndex Index of the component to remove
+ * @return Reference to the edge, owned by "from"
+ */
+ArchetypeEdge& ArchetypeManager::GetRemoveEdge(Archetype* from, size_t componentIndex)
+{
+	ArchetypeEdge& edge{ from->GetRemoveEdge(componentIndex) };
+	if (edge.to) return edge;
+
+	// Drop the value of the component if it is a shared one
+	SharedValues sharedValues{ from->GetSharedValues() };
+	auto removeIt{ std::remove_if(std::begin(sharedValues), std::end(sharedValues),
+		[componentIndex](auto const& pair) { return pair.first == componentIndex; }) };
+	sharedValues.erase(removeIt, std::end(sharedValues));
+	Archetype* to{ CreateArchetype(from->GetSignature() & ~Signature{}.set(componentIndex), sharedValues) };
+	from->LinkEdge(edge, to);
+
+	// An add edge can't name the value of a shared component, every value removes to the same archetype
+	if (!ComponentManager::GetInstance().GetComponentInfo(componentIndex).isShared)
+		to->LinkEdge(to->GetAddEdge(componentIndex), from);
+	return edge;
+}
+
+/**
+ * @brief Remove component data from an entity. This operation will move the entity to a new archetype.
+ * @param entityId Entity member id
+ * @param record Record of the entity, updated to the new archetype and row
+ * @param edge Remove edge of the component, from GetRemoveEdge
+ * @return Pointer to the archetype the entity was moved to
+ */
+Archetype* ArchetypeManager::RemoveComponent(EntityId entityId, EntityRecord& record, ArchetypeEdge const& edge)
+{
+	return MoveEntity(entityId, record, edge.to, edge.columnMap);
+}
+
+/**
+ * @brief Add a shared component to an entity or change its value. This operation will move the entity
+ * to the archetype of the new value. Values change rarely, so the move isn't cached on an edge.
+ * @param entityId Entity member id
+ * @param record Record of the entity, updated to the new archetype and row
+ * @param componentIndex Index of the shared component
+ * @param valueIndex Index of the value, from SharedComponentManager::AddValue
+ * @return Pointer to the archetype the entity was moved to
+ */
+Archetype* ArchetypeManager::SetSharedComponent(EntityId entityId, EntityRecord& record, size_t componentIndex, uint32_t valueIndex)
+{
+	Archetype* from{ record.archetype };
+	Signature signature{ from ? from->GetSignature() : Signature{} };
+	SharedValues sharedValues{ from ? from->GetSharedValues() : SharedValues{} };
+
+	// Replace the value, or insert it where it keeps the list sorted
+	auto it{ std::lower_bound(std::begin(sharedValues), std::end(sharedValues), componentIndex,
+		[](auto const& pair, size_t index) { return pair.first < index; }) };
+	if (it != std::end(sharedValues) && it->first == componentIndex)
+	{
+		if (it->second == valueIndex) return from;
+		it->second = valueIndex;
+	}
+	else
+		sharedValues.insert(it, { componentIndex, valueIndex });
+
+	Archetype* to{ CreateArchetype(signature | Signature{}.set(componentIndex), sharedValues) };
+	if (!from)
+	{
+		record.archetype = to;
+		record.row = to->AddEntity(entityId);
+		return to;
+	}
+	return MoveEntity(entityId, record, to, from->GetColumnMap(*to));
+}
+
+/**
+ * @brief Move an entity straight to the archetype of a new signature, however many components are added
+ * or removed. Components the entity keeps are moved, added ones are left for the caller to construct.
+ * Shared components that are kept keep their value. Transitions of several components aren't cached on edges.
+ * @param entityId Entity member id
+ * @param record Record of the entity, updated to the new archetype and row
+ * @param signature Signature of the entity afterwards
+ * @return Pointer to the archetype the entity was moved to
+ */
+Archetype* ArchetypeManager::ChangeSignature(EntityId entityId, EntityRecord& record, Signature signature)
+{
+	Archetype* from{ record.archetype };
+	if (from && from->GetSignature() == signature) return from;
+
+	// Drop the values of the shared components that are removed
+	SharedValues sharedValues{ from ? from->GetSharedValues() : SharedValues{} };
+	auto removeIt{ std::remove_if(std::begin(sharedValues), std::end(sharedValues),
+		[&signature](auto const& pair) { return !signature.test(pair.first); }) };
+	sharedValues.erase(removeIt, std::end(sharedValues));
+
+	Archetype* to{ CreateArchetype(signature, sharedValues) };
+	if (!from)
+	{
+		record.archetype = to;
+		record.row = to->AddEntity(entityId);
+		return to;
+	}
+	return MoveEntity(entityId, record, to, from->GetColumnMap(*to));
+}
+
+/**
+ * @brief Move an entity and the components it keeps to another archetype
+ * @param entityId Entity member id
+ * @param record Record of the entity, updated to the new archetype and row
+ * @param to Archetype to move the entity to
+ * @param columnMap Columns shared by both archetypes, from MapColumns
+ * @return Pointer to the archetype the entity was moved to
+ */
+Archetype* ArchetypeManager::MoveEntity(EntityId entityId, EntityRecord& record, Archetype* to, ColumnMap const& columnMap)
+{
+	// Column map may belong to "from", which may be destroyed once the entity leaves
+	Archetype* from{ record.archetype };
+	size_t fromRow{ record.row };
+	size_t toRow{ to->AddEntity(entityId) };
+	record.archetype = to;
+	record.row = toRow;
+
+	from->MoveComponents(fromRow, to, toRow, columnMap);
+	from->RemoveEntity(fromRow);
+	return to;
 }
 
 /**
  * @brief Get a shared pointer to desired archetype.
  * @param signature Signature of the Archetype to get
+ * @param sharedValues Values of the shared components in the signature, sorted by component index
  * @return Pointer to the created archetype, or nullptr.
  */
-Archetype* ArchetypeManager::GetArchetype(Signature signature)
+Archetype* ArchetypeManager::GetArchetype(Signature signature, SharedValues const& sharedValues)
 {
-	auto it{ mSignatureToArchetypeMap.find(signature) };
-	if (it == std::end(mSignatureToArchetypeMap))
+	auto it{ mKeyToArchetypeMap.find(ArchetypeKey{ signature, sharedValues }) };
+	if (it == std::end(mKeyToArchetypeMap))
 		return nullptr;
 	return &it->second;
 }
 
 /**
  * @brief Remove entity from archetype
- * @param[in] entity Readonly reference to entity
+ * @param record Record of the entity, cleared afterwards
+ */
+void ArchetypeManager::RemoveEntity(EntityRecord& record)
+{
+	if (record.archetype == nullptr) return;
+	Archetype* archetype{ record.archetype };
+	size_t row{ record.row };
+	record.archetype = nullptr;
+	record.row = 0;
+	archetype->RemoveEntity(row);
+}
+
+/**
+ * @brief Get the version stamped on written chunk columns, the running system's version
+ * or the global version outside of systems
+ */
+ChangeVersion ArchetypeManager::GetVersion() const
+{
+	return threadVersion ? threadVersion : mVersion.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Take a version for a system that is about to run and move the global version forward.
+ * Columns written by others afterwards compare greater than the returned version.
+ * @return Version to stamp the system's own writes with, and to compare against on its next run
+ */
+ChangeVersion ArchetypeManager::AdvanceVersion()
+{
+	return mVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
+/**
+ * @brief Set the version stamped by writes on the calling thread, 0 to use the global version
+ * @param version Version from AdvanceVersion
+ * @return Previous version of the thread
+ */
+ChangeVersion ArchetypeManager::SetThreadVersion(ChangeVersion version)
+{
+	ChangeVersion previousVersion{ threadVersion };
+	threadVersion = version;
+	return previousVersion;
+}
+
+/**
+ * @brief Get the number of times an entity was added to or removed from an archetype, starting at 1.
+ * Components only move when it changes.
+ */
+uint32_t ArchetypeManager::GetStructureVersion() const
+{
+	return mStructureVersion;
+}
+
+/**
+ * @brief Record that a row was added or removed, invalidating every cached component pointer
  */
-void ArchetypeManager::RemoveEntity(Entity const& entity)
+void ArchetypeManager::AdvanceStructureVersion()
 {
-	mSignatureToArchetypeMap[entity.GetSignature()].RemoveEntity(entity.GetId());
+	// Skip 0 on wrap around, it means "never resolved" to a ComponentRef
+	if (++mStructureVersion == 0)
+		++mStructureVersion;
 }
@@ -0,0 +1,84 @@
+/*************************************************************//**
+ * @file   ChunkManager.cpp
+ * @brief  Function definitions of the pool of fixed-size memory blocks
+ *
+ * Key features:
+ * Returns its singleton instance
+ * Allocates blocks of chunks and hands them out one by one
+ * Recycles freed chunks
+ *
+ * Usage:
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include <new>
+#include "Managers/ChunkManager.hpp"
+
+/**
+ * @brief Get the singleton instance
+ */
+ChunkManager& ChunkManager::GetInstance()
+{
+	static ChunkManager instance;
+	return instance;
+}
+
+/**
+ * @brief Frees every block. Archetypes must have returned their chunks by now.
+ */
+ChunkManager::~ChunkManager()
+{
+	for (std::byte* block : mBlocks)
+		::operator delete(block, std::align_val_t{ CHUNK_ALIGNMENT });
+}
+
+/**
+ * @brief Get a CHUNK_SIZE block of memory aligned to CHUNK_ALIGNMENT
+ * @return Pointer to the uninitialized chunk
+ */
+std::byte* ChunkManager::AllocateChunk()
+{
+	if (mFreeChunks.empty())
+	{
+		std::byte* block{ static_cast<std::byte*>(::operator new(CHUNK_SIZE * CHUNKS_PER_BLOCK, std::align_val_t{ CHUNK_ALIGNMENT })) };
+		mBlocks.push_back(block);
+
+		// Push in reverse so chunks are handed out in address order
+		for (size_t i{ CHUNKS_PER_BLOCK }; i > 0; --i)
+			mFreeChunks.push_back(block + (i - 1) * CHUNK_SIZE);
+	}
+
+	std::byte* chunk{ mFreeChunks.back() };
+	mFreeChunks.pop_back();
+	return chunk;
+}
+
+/**
+ * @brief Return a chunk to the pool. Components in it must be destroyed already.
+ * @param[in] chunk Pointer returned by AllocateChunk
+ */
+void ChunkManager::FreeChunk(std::byte* chunk)
+{
+	mFreeChunks.push_back(chunk);
+}
+
+/**
+ * @brief Get the number of chunks currently used by archetypes
+ */
+size_t ChunkManager::GetUsedChunkCount() const
+{
+	return mBlocks.size() * CHUNKS_PER_BLOCK - mFreeChunks.size();
+}
+
+/**
+ * @brief Get the number of chunks waiting in the pool
+ */
+size_t ChunkManager::GetFreeChunkCount() const
+{
+	return mFreeChunks.size();
+}
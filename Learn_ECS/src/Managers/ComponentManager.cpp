@@ -4,6 +4,7 @@
  *
  * Key features:
  * Returns its singleton instance
+ * Get the type-erased information of a component
  *
  * Usage:
  *
@@ -18,7 +19,7 @@
 #include "Core/Components.hpp"
 #include "Scripts/Zombie.hpp"
 
-ComponentManager::ComponentManager() : mTypeToSignatureMap{} {}
+ComponentManager::ComponentManager() : mComponentCount{ 0 }, mComponentInfos{} {}
 
 /**
  * @brief Get the singleton instance
@@ -39,4 +40,20 @@ void ComponentManager::Init()
 	RegisterComponent<SpriteRenderer>();
 	RegisterComponent<Animator>();
 	RegisterComponent<MonoBehaviour>();
+	RegisterComponent<Texture>();
+	RegisterComponent<Prefab>();
+	RegisterComponent<Parent>();
+	RegisterComponent<Children>();
+	RegisterComponent<HierarchyDepth>();
+	RegisterComponent<LocalToWorld>();
+}
+
+/**
+ * @brief Gets the type-erased information of a component.
+ * @param[in] componentIndex Index of the component.
+ * @return Readonly reference to the component information.
+ */
+ComponentInfo const& ComponentManager::GetComponentInfo(size_t componentIndex) const
+{
+	return mComponentInfos[componentIndex];
 }
@@ -4,8 +4,12 @@
  *
  * Key features:
  * Returns its singleton instance
- * Create an entity
+ * Create an entity, reusing the index of destroyed entities
+ * Destroy an entity
  * Get the number of existing entities
+ * Enable and disable entities in place
+ * Create prefabs and copy them into new entities
+ * Parent entities and keep the depth of their subtree up to date
  *
  * Usage:
  *
@@ -16,13 +20,16 @@
  * Copyright 2024, Digipen Institute of Technology
 *****************************************************************/
 #include <cassert>
+#include <algorithm>
+#include <iostream>
 #include "Managers/EntityManager.hpp"
-#include "Managers/HandleManager.hpp"
+#include "Components/Prefab.hpp"
+#include "Components/Parent.hpp"
+#include "Components/LocalToWorld.hpp"
 
-EntityManager::EntityManager() : mIdCounter{0}
-{
-	mEntities.reserve(MAX_ENTITIES);
-}
+EntityManager::EntityManager() :
+	mPages{}, mFreeIndices{}, mSlotCount{ 0 }, mEntityCount{ 0 }
+{}
 
 /**
  * @brief Get the singleton instance
@@ -39,12 +46,96 @@ EntityManager& EntityManager::GetInstance()
  */
 Entity& EntityManager::CreateEntity()
 {
-	EntityId id{ mIdCounter++ };
-	size_t index{ mEntities.size() };
-	mEntities.push_back(Entity{ id });
-	mEntityIdToIndexMap[id] = index;
-	mIndexToEntityIdMap[index] = id;
-	return mEntities[index];
+	size_t index{};
+	uint32_t generation{ 0 };
+	if (!mFreeIndices.empty())
+	{
+		index = mFreeIndices.back();
+		mFreeIndices.pop_back();
+		generation = GetEntityGeneration(GetSlot(index).entity.GetId()) + 1;
+	}
+	else
+	{
+		assert(mSlotCount < MAX_ENTITIES && "Too many entities.");
+		index = mSlotCount++;
+		if (index / ENTITIES_PER_PAGE >= mPages.size())
+			mPages.push_back(std::make_unique<EntitySlot[]>(ENTITIES_PER_PAGE));
+	}
+
+	EntitySlot& slot{ GetSlot(index) };
+	slot.entity = Entity{ MakeEntityId(index, generation) };
+	slot.record = EntityRecord{};
+	slot.isAlive = true;
+	++mEntityCount;
+	return slot.entity;
+}
+
+/**
+ * @brief Create a prefab, an entity with the Prefab tag. Add its components like any entity,
+ * queries skip it until it is copied with Instantiate.
+ * @return A reference to the prefab.
+ */
+Entity& EntityManager::CreatePrefab()
+{
+	Entity& prefab{ CreateEntity() };
+	AddComponent<Prefab>(prefab);
+	return prefab;
+}
+
+/**
+ * @brief Create copies of a prefab, without the Prefab tag. The archetype is resolved once
+ * and every column is copied from the prefab's row.
+ * @param prefab Entity created with CreatePrefab
+ * @param count Number of copies
+ */
+void EntityManager::Instantiate(Entity const& prefab, size_t count)
+{
+	CopyPrefab(prefab, count);
+}
+
+/**
+ * @brief Copy a prefab into new entities, used by Instantiate
+ * @return Ids of the copies, empty if the prefab can't be copied
+ */
+std::vector<EntityId> EntityManager::CopyPrefab(Entity const& prefab, size_t count)
+{
+	size_t prefabIndex{ ComponentManager::GetComponentIndex<Prefab>() };
+	EntityRecord const& prefabRecord{ GetRecord(prefab.GetId()) };
+	Archetype* from{ prefabRecord.archetype };
+	if (from == nullptr || !from->GetSignature().test(prefabIndex))
+	{
+		std::cout << __FUNCTION__ << "() Entity " << prefab.GetId() << " is not a prefab.\n";
+		return {};
+	}
+	for (size_t componentIndex : from->GetComponentIds())
+	{
+		ComponentInfo const& info{ ComponentManager::GetInstance().GetComponentInfo(componentIndex) };
+		if (info.copyConstruct) continue;
+		std::cout << __FUNCTION__ << "() Component " << info.name << " can't be copied.\n";
+		return {};
+	}
+
+	// Copies live where the prefab would be without its tag
+	ArchetypeEdge const& edge{ ArchetypeManager::GetInstance().GetRemoveEdge(from, prefabIndex) };
+	Archetype* to{ edge.to };
+	size_t firstRow{ to->GetEntityCount() };
+	to->Reserve(count);
+
+	std::vector<EntityId> entityIds;
+	entityIds.reserve(count);
+	for (size_t i{}; i < count; ++i)
+	{
+		Entity& entity{ CreateEntity() };
+		EntityId entityId{ entity.GetId() };
+		entity.SetSignature(to->GetSignature());
+
+		EntityRecord& record{ GetRecord(entityId) };
+		record.archetype = to;
+		record.row = to->AddEntity(entityId);
+		entityIds.push_back(entityId);
+	}
+	from->CopyComponents(prefabRecord.row, to, firstRow, count, edge.columnMap);
+	return entityIds;
 }
 
 /**
@@ -54,50 +145,213 @@ Entity& EntityManager::CreateEntity()
  */
 Entity& EntityManager::GetEntity(EntityId entityId)
 {
-	auto indexIt{ mEntityIdToIndexMap.find(entityId) };
-	assert(indexIt != std::end(mEntityIdToIndexMap) && "Entity ID not found.");
-	return mEntities[indexIt->second];
+	assert(IsAlive(entityId) && "Entity ID not found.");
+	return GetSlot(GetEntityIndex(entityId)).entity;
+}
+
+/**
+ * @brief Check if an entity ID belongs to an existing entity.
+ * IDs of destroyed entities stay invalid even after their index is reused.
+ * @param[in] entityId ID of the entity
+ */
+bool EntityManager::IsAlive(EntityId entityId) const
+{
+	size_t index{ GetEntityIndex(entityId) };
+	if (index >= mSlotCount) return false;
+	EntitySlot const& slot{ GetSlot(index) };
+	return slot.isAlive && slot.entity.GetId() == entityId;
 }
 
 /**
- * @brief Destroy an entity.
+ * @brief Destroy an entity. Its children are detached and become roots.
  * @paran[in] entity Reference to an entity
  */
 void EntityManager::DestroyEntity(Entity const& entity)
 {
 	EntityId entityId{ entity.GetId() };
+	if (!IsAlive(entityId)) return;
+
+	// Forget the entity in its parent's list
+	if (Parent const* parent{ GetComponent<Parent const>(entity) })
+		RemoveChildId(parent->parentId, entityId);
 
-	auto removedIndexIt{ mEntityIdToIndexMap.find(entityId) };
-	if (removedIndexIt == std::end(mEntityIdToIndexMap)) return;
+	// Its own children become roots, left in world space. Copied, detaching them may move the list's chunk.
+	if (Children const* children{ GetComponent<Children const>(entity) })
+	{
+		std::vector<EntityId> childIds{ children->childIds };
+		for (EntityId childId : childIds)
+		{
+			if (!IsAlive(childId)) continue;
+			Entity& child{ GetEntity(childId) };
+			Parent const* parent{ GetComponent<Parent const>(child) };
+			if (parent == nullptr || parent->parentId != entityId) continue;
+			RemoveComponent<Parent>(child);
+			SetDepth(child, 0);
+		}
+	}
 
 	// Remove from archetype
 	// TODO Maybe decouple
-	HandleManager& hm{ HandleManager::GetInstance() };
-	hm.DestroyEntityHandles(entity);
-	ArchetypeManager::GetInstance().RemoveEntity(entity);
+	size_t index{ GetEntityIndex(entityId) };
+	EntitySlot& slot{ GetSlot(index) };
+	ArchetypeManager::GetInstance().RemoveEntity(slot.record);
 
-	size_t removedIndex{ removedIndexIt->second };
-	size_t lastIndex{ mEntities.size() - 1 };
-	EntityId lastEntityId{ mIndexToEntityIdMap[lastIndex] };
+	// Keep the id so the next entity at this index gets the next generation
+	slot.isAlive = false;
+	mFreeIndices.push_back(index);
+	--mEntityCount;
+}
 
-	mEntityIdToIndexMap[lastEntityId] = removedIndex;
-	mIndexToEntityIdMap[removedIndex] = lastEntityId;
+/**
+ * @brief Get the number of existing entities
+ * @return The number of entities
+ */
+size_t EntityManager::GetEntityCount() const
+{
+	return mEntityCount;
+}
 
-	mEntityIdToIndexMap.erase(entityId);
-	mIndexToEntityIdMap.erase(lastIndex);
+/**
+ * @brief Enable or disable an entity. Disabled entities keep their components and row,
+ * but are skipped by Chunk::ForEachEnabledRange.
+ * @param[in] entity Reference to entity
+ * @param[in] isEnabled New state of the entity
+ */
+void EntityManager::SetEnabled(Entity const& entity, bool isEnabled)
+{
+	EntityRecord const& record{ GetRecord(entity.GetId()) };
+	if (record.archetype == nullptr)
+	{
+		std::cout << __FUNCTION__ << "() Entity " << entity.GetId() << " has no components.\n";
+		return;
+	}
+	record.archetype->SetEnabled(record.row, isEnabled);
+}
 
-	mEntities[removedIndex] = std::move(mEntities[lastIndex]);
-	mEntities.pop_back();
+/**
+ * @brief Check if an entity is enabled. Entities without components are never enabled.
+ * @param[in] entity Reference to entity
+ */
+bool EntityManager::IsEnabled(Entity const& entity)
+{
+	EntityRecord const& record{ GetRecord(entity.GetId()) };
+	return record.archetype != nullptr && record.archetype->IsEnabled(record.row);
+}
+
+/**
+ * @brief Make an entity the child of another. Its Transform becomes relative to the parent.
+ * Both entities get a LocalToWorld if they don't have one, and the child's subtree moves one level down.
+ * @param[in] child Reference to the child entity
+ * @param[in] parent Reference to the parent entity, can't be the child or one of its descendants
+ */
+void EntityManager::SetParent(Entity& child, Entity& parent)
+{
+	EntityId childId{ child.GetId() };
+	EntityId parentId{ parent.GetId() };
+	for (EntityId ancestorId{ parentId }; IsAlive(ancestorId);)
+	{
+		if (ancestorId == childId)
+		{
+			std::cout << __FUNCTION__ << "() Entity " << parentId << " is a descendant of " << childId << ".\n";
+			return;
+		}
+		Parent const* ancestorParent{ GetComponent<Parent const>(GetEntity(ancestorId)) };
+		if (ancestorParent == nullptr) break;
+		ancestorId = ancestorParent->parentId;
+	}
+
+	if (Parent* oldParent{ GetComponent<Parent>(child) })
+	{
+		if (oldParent->parentId == parentId) return;
+		RemoveChildId(oldParent->parentId, childId);
+		oldParent->parentId = parentId;
+	}
+	else
+	{
+		Parent component{};
+		component.parentId = parentId;
+		AddComponent<Parent>(child, std::move(component));
+	}
+
+	AddComponent<Children>(parent);
+	GetComponent<Children>(parent)->childIds.push_back(childId);
+	AddComponent<LocalToWorld>(parent);
+	AddComponent<LocalToWorld>(child);
 
-	if (mEntities.size() > 0)
-		hm.UpdateEntityHandles(mEntities[removedIndex]);
+	HierarchyDepth const* parentDepth{ GetSharedComponent<HierarchyDepth>(parent) };
+	SetDepth(child, parentDepth ? parentDepth->depth + 1 : 1);
 }
 
 /**
- * @brief Get the number of existing entities
- * @return The number of entities
+ * @brief Detach an entity from its parent. Its Transform becomes relative to the world.
+ * @param[in] child Reference to the child entity
  */
-size_t EntityManager::GetEntityCount() const
+void EntityManager::RemoveParent(Entity& child)
+{
+	Parent const* parent{ GetComponent<Parent const>(child) };
+	if (parent == nullptr) return;
+
+	RemoveChildId(parent->parentId, child.GetId());
+	RemoveComponent<Parent>(child);
+	SetDepth(child, 0);
+}
+
+/**
+ * @brief Set the HierarchyDepth of an entity and of its descendants, used by SetParent and RemoveParent
+ */
+void EntityManager::SetDepth(Entity& entity, uint32_t depth)
+{
+	if (depth == 0)
+		RemoveComponent<HierarchyDepth>(entity);
+	else
+	{
+		HierarchyDepth hierarchyDepth{};
+		hierarchyDepth.depth = depth;
+		SetSharedComponent(entity, hierarchyDepth);
+	}
+
+	// Copied, moving the children may move the chunk the list lives in
+	Children const* children{ GetComponent<Children const>(entity) };
+	if (children == nullptr) return;
+	std::vector<EntityId> childIds{ children->childIds };
+	for (EntityId childId : childIds)
+	{
+		if (IsAlive(childId))
+			SetDepth(GetEntity(childId), depth + 1);
+	}
+}
+
+/**
+ * @brief Remove an entity from the Children of its parent
+ */
+void EntityManager::RemoveChildId(EntityId parentId, EntityId childId)
+{
+	if (!IsAlive(parentId)) return;
+	Children* children{ GetComponent<Children>(GetEntity(parentId)) };
+	if (children == nullptr) return;
+	std::vector<EntityId>& childIds{ children->childIds };
+	childIds.erase(std::remove(std::begin(childIds), std::end(childIds), childId), std::end(childIds));
+}
+
+/**
+ * @brief Get the record of where an entity lives
+ * @param[in] entityId ID of the entity
+ * @return Reference to the record
+ */
+EntityRecord& EntityManager::GetRecord(EntityId entityId)
+{
+	return GetSlot(GetEntityIndex(entityId)).record;
+}
+
+/**
+ * @brief Get the slot of an entity index
+ */
+EntityManager::EntitySlot& EntityManager::GetSlot(size_t index)
+{
+	return mPages[index / ENTITIES_PER_PAGE][index % ENTITIES_PER_PAGE];
+}
+
+EntityManager::EntitySlot const& EntityManager::GetSlot(size_t index) const
 {
-	return mEntities.size();
+	return mPages[index / ENTITIES_PER_PAGE][index % ENTITIES_PER_PAGE];
 }
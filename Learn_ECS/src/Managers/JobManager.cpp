@@ -0,0 +1,163 @@
+/*************************************************************//**
+ * @file   JobManager.cpp
+ * @brief  Function definitions of JobManager
+ *
+ * Key features:
+ * Returns its singleton instance
+ * Starts and joins the worker threads
+ * Schedule jobs, pop them from the own queue or steal them, and wait on them
+ *
+ * Usage:
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include "Managers/JobManager.hpp"
+
+thread_local size_t JobManager::queueIndex{ 0 };
+
+/**
+ * @brief Constructor. Starts one worker per hardware thread, minus the main thread.
+ * Queue 0 belongs to the main thread, queue i to worker i - 1.
+ */
+JobManager::JobManager() :
+	mWorkers{}, mQueues{}, mJobCount{ 0 }, mSleepMutex{}, mCondition{}, mIsStopping{ false }
+{
+	unsigned threadCount{ std::thread::hardware_concurrency() };
+	size_t workerCount{ threadCount > 1 ? threadCount - 1 : 0 };
+	mQueues.reserve(workerCount + 1);
+	for (size_t i{}; i < workerCount + 1; ++i)
+		mQueues.push_back(std::make_unique<JobQueue>());
+
+	mWorkers.reserve(workerCount);
+	for (size_t i{}; i < workerCount; ++i)
+		mWorkers.emplace_back(&JobManager::WorkerLoop, this, i + 1);
+}
+
+/**
+ * @brief Destructor. Lets the workers finish their current job and joins them.
+ */
+JobManager::~JobManager()
+{
+	{
+		std::lock_guard<std::mutex> lock{ mSleepMutex };
+		mIsStopping = true;
+	}
+	mCondition.notify_all();
+	for (std::thread& worker : mWorkers)
+		worker.join();
+}
+
+/**
+ * @brief Get the singleton instance
+ */
+JobManager& JobManager::GetInstance()
+{
+	static JobManager instance;
+	return instance;
+}
+
+/**
+ * @brief Queue a job on the calling thread's queue, it will be run by
+ * this thread or stolen by another one
+ * @param job Function to run
+ */
+void JobManager::Schedule(Job job)
+{
+	{
+		JobQueue& queue{ *mQueues[queueIndex] };
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		queue.jobs.push_back(std::move(job));
+	}
+	{
+		// Taking the lock makes sure a worker checking mJobCount doesn't miss the notify
+		std::lock_guard<std::mutex> lock{ mSleepMutex };
+		mJobCount.fetch_add(1, std::memory_order_release);
+	}
+	mCondition.notify_one();
+}
+
+/**
+ * @brief Run queued jobs on the calling thread until the counter reaches zero
+ * @param[in] counter Decremented by the jobs being waited on
+ */
+void JobManager::Wait(std::atomic<size_t> const& counter)
+{
+	while (counter.load(std::memory_order_acquire) > 0)
+	{
+		if (!TryRunJob())
+			std::this_thread::yield();
+	}
+}
+
+/**
+ * @brief Get the number of worker threads, 0 if jobs only run while waiting
+ */
+size_t JobManager::GetWorkerCount() const
+{
+	return mWorkers.size();
+}
+
+/**
+ * @brief Loop of every worker thread
+ * @param index Index of the worker's own queue
+ */
+void JobManager::WorkerLoop(size_t index)
+{
+	queueIndex = index;
+	while (true)
+	{
+		if (TryRunJob()) continue;
+
+		std::unique_lock<std::mutex> lock{ mSleepMutex };
+		mCondition.wait(lock, [this]() { return mIsStopping || mJobCount.load(std::memory_order_acquire) > 0; });
+		if (mIsStopping) return;
+	}
+}
+
+/**
+ * @brief Pop a job from the calling thread's queue, or steal one, and run it
+ * @return false if there was no job
+ */
+bool JobManager::TryRunJob()
+{
+	Job job;
+	bool hasJob{ PopJob(queueIndex, job) };
+	for (size_t i{ 1 }; !hasJob && i < mQueues.size(); ++i)
+		hasJob = StealJob((queueIndex + i) % mQueues.size(), job);
+	if (!hasJob) return false;
+
+	mJobCount.fetch_sub(1, std::memory_order_acq_rel);
+	job();
+	return true;
+}
+
+/**
+ * @brief Take the newest job of a queue
+ */
+bool JobManager::PopJob(size_t index, Job& job)
+{
+	JobQueue& queue{ *mQueues[index] };
+	std::lock_guard<std::mutex> lock{ queue.mutex };
+	if (queue.jobs.empty()) return false;
+	job = std::move(queue.jobs.back());
+	queue.jobs.pop_back();
+	return true;
+}
+
+/**
+ * @brief Take the oldest job of a queue
+ */
+bool JobManager::StealJob(size_t index, Job& job)
+{
+	JobQueue& queue{ *mQueues[index] };
+	std::lock_guard<std::mutex> lock{ queue.mutex };
+	if (queue.jobs.empty()) return false;
+	job = std::move(queue.jobs.front());
+	queue.jobs.pop_front();
+	return true;
+}
@@ -0,0 +1,33 @@
+/*************************************************************//**
+ * @file   SharedComponentManager.cpp
+ * @brief  Function definitions of SharedComponentManager
+ *
+ * Key features:
+ * Returns its singleton instance
+ *
+ * Usage:
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include "Managers/SharedComponentManager.hpp"
+
+/**
+ * @brief Constructor
+ */
+SharedComponentManager::SharedComponentManager() :
+	mValueLists{}
+{}
+
+/**
+ * @brief Get the singleton instance
+ */
+SharedComponentManager& SharedComponentManager::GetInstance()
+{
+	static SharedComponentManager instance;
+	return instance;
+}
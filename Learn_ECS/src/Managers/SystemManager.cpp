@@ -5,7 +5,9 @@
  * Key features:
  * Adds a system
  * Initialize vector of systems
- * Update vector of systems
+ * Update vector of systems, in parallel on JobManager's workers when their accesses don't conflict
+ * Play back the command buffers after the update
+ * Give every system update its own change version
  *
  * Usage:
  * For each system, use AddSystem();
@@ -20,9 +22,20 @@
 
 #include <cassert>
 #include "Managers/SystemManager.hpp"
+#include "Managers/JobManager.hpp"
+#include "Managers/ArchetypeManager.hpp"
 
 std::vector<std::shared_ptr<ISystem>> SystemManager::systems;
 std::unordered_map<std::string, std::shared_ptr<ISystem>> SystemManager::stringToSystemMap;
+CommandBuffer SystemManager::commandBuffer;
+std::vector<std::unique_ptr<CommandBuffer>> SystemManager::systemCommandBuffers;
+thread_local CommandBuffer* SystemManager::currentCommandBuffer{ nullptr };
+std::vector<ChangeVersion> SystemManager::systemVersions;
+thread_local ChangeVersion SystemManager::lastVersion{ 0 };
+std::vector<std::vector<size_t>> SystemManager::dependents;
+std::unique_ptr<std::atomic<size_t>[]> SystemManager::dependencyCounts;
+std::atomic<size_t> SystemManager::remainingSystems{ 0 };
+bool SystemManager::isParallel{ true };
 
 /**
  * @brief Adds a system of base type ISystem
@@ -33,6 +46,10 @@ void SystemManager::AddSystem(std::shared_ptr<ISystem> const& system, std::strin
 {
 	SystemManager::systems.push_back(system);
 	stringToSystemMap[systemName] = system;
+	systemCommandBuffers.push_back(std::make_unique<CommandBuffer>());
+	systemVersions.push_back(0);
+	dependents.resize(systems.size());
+	dependencyCounts = std::make_unique<std::atomic<size_t>[]>(systems.size());
 }
 
 /**
@@ -46,13 +63,137 @@ void SystemManager::InitSystems()
 }
 
 /**
- * @brief Updates all system in the systems static member.
+ * @brief Updates all system in the systems static member, then plays back the command buffers.
+ * Systems are ordered by the components they access, in the order they were added when they conflict.
  * Is called every frame.
  */
 void SystemManager::UpdateSystems()
 {
-	for (auto& pSystem : systems)
-		pSystem->Update();
+	size_t systemCount{ systems.size() };
+	if (!isParallel || JobManager::GetInstance().GetWorkerCount() == 0)
+	{
+		for (size_t i{}; i < systemCount; ++i)
+			UpdateSystem(i);
+	}
+	else
+	{
+		// A system waits on every earlier system it conflicts with, so the graph can't have cycles
+		std::vector<SystemAccess> accesses;
+		accesses.reserve(systemCount);
+		for (auto& pSystem : systems)
+			accesses.push_back(pSystem->GetAccess());
+
+		for (size_t i{}; i < systemCount; ++i)
+		{
+			dependents[i].clear();
+			dependencyCounts[i].store(0, std::memory_order_relaxed);
+		}
+		for (size_t i{}; i < systemCount; ++i)
+		{
+			for (size_t j{ i + 1 }; j < systemCount; ++j)
+			{
+				if (!IsConflicting(accesses[i], accesses[j])) continue;
+				dependents[i].push_back(j);
+				dependencyCounts[j].fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		// Find the roots before scheduling any, a running system may already release its dependents
+		std::vector<size_t> roots;
+		for (size_t i{}; i < systemCount; ++i)
+		{
+			if (dependencyCounts[i].load(std::memory_order_relaxed) == 0)
+				roots.push_back(i);
+		}
+
+		JobManager& jobManager{ JobManager::GetInstance() };
+		remainingSystems.store(systemCount, std::memory_order_release);
+		for (size_t root : roots)
+			jobManager.Schedule([root]() { RunSystem(root); });
+		jobManager.Wait(remainingSystems);
+	}
+
+	// Sync point, no system is iterating anymore
+	for (auto& systemCommandBuffer : systemCommandBuffers)
+		systemCommandBuffer->Playback();
+	commandBuffer.Playback();
+}
+
+/**
+ * @brief Gets the command buffer of the system running on this thread,
+ * or the shared one outside of UpdateSystems.
+ * @return Reference to the command buffer
+ */
+CommandBuffer& SystemManager::GetCommandBuffer()
+{
+	return currentCommandBuffer ? *currentCommandBuffer : commandBuffer;
+}
+
+/**
+ * @brief Run the systems one at a time in the order they were added. Deterministic, for debugging.
+ * @param[in] parallel false to run serially
+ */
+void SystemManager::SetParallel(bool parallel)
+{
+	isParallel = parallel;
+}
+
+/**
+ * @brief Gets the version the running system had on its previous update, 0 if it never ran.
+ * Columns written since then compare greater, see Query::ForEachChangedChunk.
+ */
+ChangeVersion SystemManager::GetLastVersion()
+{
+	return lastVersion;
+}
+
+/**
+ * @brief Check if two systems can't run at the same time
+ */
+bool SystemManager::IsConflicting(SystemAccess const& lhs, SystemAccess const& rhs)
+{
+	if (lhs.isExclusive || rhs.isExclusive) return true;
+	return lhs.writes.Intersects(rhs.reads | rhs.writes) || rhs.writes.Intersects(lhs.reads);
+}
+
+/**
+ * @brief Update a system with its own command buffer and version
+ * @param[in] index Index of the system
+ */
+void SystemManager::UpdateSystem(size_t index)
+{
+	// A system waiting on a ParallelFor can run another system on the same thread
+	ArchetypeManager& archetypeManager{ ArchetypeManager::GetInstance() };
+	ChangeVersion version{ archetypeManager.AdvanceVersion() };
+	CommandBuffer* previousCommandBuffer{ currentCommandBuffer };
+	ChangeVersion previousLastVersion{ lastVersion };
+	ChangeVersion previousVersion{ ArchetypeManager::SetThreadVersion(version) };
+	currentCommandBuffer = systemCommandBuffers[index].get();
+	lastVersion = systemVersions[index];
+
+	systems[index]->Update();
+
+	systemVersions[index] = version;
+	currentCommandBuffer = previousCommandBuffer;
+	lastVersion = previousLastVersion;
+	ArchetypeManager::SetThreadVersion(previousVersion);
+}
+
+/**
+ * @brief Update a system, then schedule the systems that were waiting on it
+ * @param[in] index Index of the system
+ */
+void SystemManager::RunSystem(size_t index)
+{
+	UpdateSystem(index);
+
+	JobManager& jobManager{ JobManager::GetInstance() };
+	for (size_t dependent : dependents[index])
+	{
+		if (dependencyCounts[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			jobManager.Schedule([dependent]() { RunSystem(dependent); });
+	}
+	remainingSystems.fetch_sub(1, std::memory_order_acq_rel);
 }
 
 /**
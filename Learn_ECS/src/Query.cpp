@@ -0,0 +1,117 @@
+/*************************************************************//**
+ * @file   Query.cpp
+ * @brief  Function definitions of QueryBase, the type-erased part of Query.
+ *
+ * Key features:
+ * Build the signature of the queried components
+ * Match archetypes as they are created
+ * Unmatch archetypes before they are destroyed
+ *
+ * Usage:
+ * ArchetypeManager calls Match and Unmatch, systems only read the results.
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include <algorithm>
+#include "Query.hpp"
+#include "Managers/ArchetypeManager.hpp"
+#include "Components/Prefab.hpp"
+
+/**
+ * @brief Constructor
+ * @param[in] componentIndices Index of every queried component, in the order of the columns
+ */
+QueryBase::QueryBase(std::vector<size_t> componentIndices) :
+	mSignature{}, mComponentIndices{ std::move(componentIndices) }, mArchetypes{}, mColumns{}
+{
+	for (size_t index : mComponentIndices)
+		mSignature.set(index);
+}
+
+/**
+ * @brief Get the combined signature of the queried components
+ */
+Signature QueryBase::GetSignature() const
+{
+	return mSignature;
+}
+
+/**
+ * @brief Get the archetypes that contain every queried component
+ * @return Readonly reference to the vector of archetypes
+ */
+ArchetypeSet const& QueryBase::GetArchetypes() const
+{
+	return mArchetypes;
+}
+
+/**
+ * @brief Get the number of entities in the matching archetypes
+ */
+size_t QueryBase::GetEntityCount() const
+{
+	size_t count{};
+	for (Archetype* archetype : mArchetypes)
+		count += archetype->GetEntityCount();
+	return count;
+}
+
+/**
+ * @brief Get the columns of the queried components in a matching archetype
+ * @param[in] archetypeIndex Index of the archetype in GetArchetypes()
+ * @return Pointer to one column per queried component
+ */
+size_t const* QueryBase::GetColumns(size_t archetypeIndex) const
+{
+	return mColumns.data() + archetypeIndex * mComponentIndices.size();
+}
+
+/**
+ * @brief Add an archetype to the query if it contains every queried component.
+ * Prefabs only match queries that ask for the Prefab tag.
+ * @param archetype Newly created archetype
+ */
+void QueryBase::Match(Archetype* archetype)
+{
+	Signature signature{ archetype->GetSignature() };
+	if (!signature.Contains(mSignature)) return;
+
+	size_t prefabIndex{ ComponentId<Prefab>::index };
+	if (prefabIndex != MAX_COMPONENTS && signature.test(prefabIndex) && !mSignature.test(prefabIndex)) return;
+
+	mArchetypes.push_back(archetype);
+	for (size_t index : mComponentIndices)
+		mColumns.push_back(archetype->GetColumnIndex(index));
+}
+
+/**
+ * @brief Remove an archetype from the query
+ * @param archetype Archetype that is about to be destroyed
+ */
+void QueryBase::Unmatch(Archetype* archetype)
+{
+	auto it{ std::find(std::begin(mArchetypes), std::end(mArchetypes), archetype) };
+	if (it == std::end(mArchetypes)) return;
+
+	// Swap with the last archetype, along with its columns
+	size_t removedIndex{ static_cast<size_t>(it - std::begin(mArchetypes)) };
+	size_t lastIndex{ mArchetypes.size() - 1 };
+	size_t stride{ mComponentIndices.size() };
+	mArchetypes[removedIndex] = mArchetypes[lastIndex];
+	std::copy_n(std::begin(mColumns) + lastIndex * stride, stride, std::begin(mColumns) + removedIndex * stride);
+	mArchetypes.pop_back();
+	mColumns.resize(lastIndex * stride);
+}
+
+/**
+ * @brief Get the version stamped on the columns written by the calling thread
+ */
+ChangeVersion QueryBase::GetWriteVersion()
+{
+	return ArchetypeManager::GetInstance().GetVersion();
+}
@@ -6,10 +6,16 @@
  * Key features:
  * Renders quads by MAX_QUADS amount. Each instance of quad will have their own
  * transform matrices, UVs, texture units, and color.
+ * Matrices are read from LocalToWorld, computed by TransformSystem.
+ * UVs are cached per chunk and only recomputed when the chunk's SpriteRenderers change.
+ * Every entity of a chunk shares its Texture, so a texture unit is assigned once per chunk.
+ * Disabled entities are left out of the batches.
  *
  * Usage:
  *
  * Dependencies:
+ * Only entities with LocalToWorld, SpriteRenderer and a Texture shared component are drawn.
+ * Add LocalToWorld next to Transform, sprites missing either are skipped with a message the first time.
  *
  * @author HONG Xian Xiang
  * @date   3rd October 2024
@@ -22,7 +28,7 @@
 #include <algorithm>
 #include "Renderers/QuadInstancedRenderer.hpp"
 #include "Managers/ArchetypeManager.hpp"
-#include "Components/Transform.hpp"
+#include "Managers/ComponentManager.hpp"
 #include "Components/SpriteRenderer.hpp"
 #include "Application.hpp"
 #include "Shader.hpp"
@@ -32,7 +38,14 @@ GLuint QuadInstancedRenderer::vbo{ 0 };
 GLfloat QuadInstancedRenderer::samplers[MAX_QUADS];
 glm::vec2 QuadInstancedRenderer::uvs[MAX_VERTS];
 glm::mat3 QuadInstancedRenderer::transforms[MAX_QUADS];
+std::unordered_map<SpriteRenderer const*, QuadInstancedRenderer::ChunkCache> QuadInstancedRenderer::chunkCaches;
+ChangeVersion QuadInstancedRenderer::lastVersion{ 0 };
+size_t QuadInstancedRenderer::frameCount{ 0 };
 std::unordered_map<TextureId, GLfloat> QuadInstancedRenderer::texIdToSamplerMap;
+Query<LocalToWorld const, SpriteRenderer const>* QuadInstancedRenderer::query{ nullptr };
+Query<SpriteRenderer const>* QuadInstancedRenderer::spriteQuery{ nullptr };
+bool QuadInstancedRenderer::isMissingLocalToWorldReported{ false };
+bool QuadInstancedRenderer::isMissingTextureReported{ false };
 
 /**
  * @brief Initialize shaders and buffers
@@ -41,6 +54,8 @@ void QuadInstancedRenderer::Init()
 {
 	InitShaders();
 	InitBuffers();
+	query = &ArchetypeManager::GetInstance().GetQuery<LocalToWorld const, SpriteRenderer const>();
+	spriteQuery = &ArchetypeManager::GetInstance().GetQuery<SpriteRenderer const>();
 }
 
 /**
@@ -121,9 +136,6 @@ void QuadInstancedRenderer::InitBuffers()
  */
 void QuadInstancedRenderer::Render()
 {
-	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	ArchetypeSet set{ am.GetArchetypeSet<Transform, SpriteRenderer>() };
-
 	// Initialize uniform sampler array
 	GLint maxTextureUnits{ Application::GetMaxTextureUnits() };
 	std::vector<GLint> uSamplers(maxTextureUnits);
@@ -137,82 +149,131 @@ void QuadInstancedRenderer::Render()
 	quadShader->SetUniform("uSamplers", maxTextureUnits, uSamplers.data());
 	quadShader->SetUniform("u_world_to_ndc_mtx", &Application::GetWorldToNDCMatrix()[0][0]);
 
-	for (auto& arch : set)
+	// Columns written after the previous frame compare greater than since
+	ChangeVersion since{ lastVersion };
+	lastVersion = ArchetypeManager::GetInstance().AdvanceVersion();
+
+	// Sprites without a LocalToWorld don't match the query at all
+	if (!isMissingLocalToWorldReported)
 	{
-		auto& tv{ arch->GetComponentArray<Transform>() };
-		auto& srv{ arch->GetComponentArray<SpriteRenderer>() };
+		size_t localToWorldIndex{ ComponentManager::GetComponentIndex<LocalToWorld>() };
+		for (Archetype* archetype : spriteQuery->GetArchetypes())
+		{
+			if (archetype->GetEntityCount() == 0 || archetype->GetColumnIndex(localToWorldIndex) != Archetype::INVALID_COLUMN) continue;
+			std::cout << __FUNCTION__ << "() Sprites without a LocalToWorld aren't drawn, add one next to their Transform.\n";
+			isMissingLocalToWorldReported = true;
+			break;
+		}
+	}
 
-		size_t entityCount{ arch->GetEntityCount() };
-		size_t instCount{}, vertCount{};
-		for (size_t i{}; i < entityCount; ++i)
+	// Caches are created here, the jobs below only look them up. Chunks without a texture aren't drawn.
+	++frameCount;
+	query->ForEachChunk([](Chunk& chunk, LocalToWorld const*, SpriteRenderer const* srv)
+	{
+		if (chunk.GetSharedComponent<Texture>())
+			chunkCaches[srv].frame = frameCount;
+		else if (!isMissingTextureReported)
 		{
-			Transform const& t{ std::any_cast<Transform&>(tv[i]) };
-			CalculateTransform(transforms[instCount], t);
+			std::cout << "Render() Sprites without a Texture aren't drawn, set one with SetSharedComponent.\n";
+			isMissingTextureReported = true;
+		}
+	});
 
-			SpriteRenderer const& sr{ std::any_cast<SpriteRenderer&>(srv[i]) };
-			CalculateUVs(&uvs[vertCount], sr);
+	// Only the chunks that changed are recomputed, on JobManager's threads
+	query->ParallelForEachChunk([since](size_t, Chunk& chunk, LocalToWorld const*, SpriteRenderer const* srv)
+	{
+		auto cacheIt{ chunkCaches.find(srv) };
+		if (cacheIt == std::end(chunkCaches)) return;
 
-			texIdToSamplerMap.insert({ sr.sprite.mId, static_cast<GLfloat>(texIdToSamplerMap.size()) });
-			samplers[instCount] = texIdToSamplerMap[sr.sprite.mId];
+		ChunkCache& cache{ cacheIt->second };
+		Texture const& texture{ *chunk.GetSharedComponent<Texture>() };
+		size_t entityCount{ chunk.GetEntityCount() };
+		bool isResized{ cache.uvs.size() != entityCount * 4 };
+		if (isResized)
+			cache.uvs.resize(entityCount * 4);
 
-			++instCount;
-			vertCount += 4;
+		if (isResized || chunk.HasChanged<SpriteRenderer>(since))
+		{
+			for (size_t i{}; i < entityCount; ++i)
+				CalculateUVs(&cache.uvs[i * 4], srv[i], texture);
+		}
+	});
 
-			// Flush if
-			// 1. Batch size reached
-			// 2. Last batch reached
-			// 3. Out of texture units
-			if (instCount >= MAX_QUADS ||
-				(i + 1) >= entityCount ||
-				texIdToSamplerMap.size() >= maxTextureUnits)
+	size_t instCount{};
+	query->ForEachChunk([&](Chunk& chunk, LocalToWorld const* lv, SpriteRenderer const* srv)
+	{
+		auto cacheIt{ chunkCaches.find(srv) };
+		if (cacheIt == std::end(chunkCaches)) return;
+		ChunkCache const& cache{ cacheIt->second };
+
+		// Flush if out of texture units
+		TextureId textureId{ chunk.GetSharedComponent<Texture>()->mId };
+		auto samplerIt{ texIdToSamplerMap.find(textureId) };
+		if (samplerIt == std::end(texIdToSamplerMap))
+		{
+			if (texIdToSamplerMap.size() >= static_cast<size_t>(maxTextureUnits))
 			{
 				ActivateTextureUnits();
 				Flush(instCount);
 				instCount = 0;
-				vertCount = 0;
 				texIdToSamplerMap.clear();
 			}
+			samplerIt = texIdToSamplerMap.emplace(textureId, static_cast<GLfloat>(texIdToSamplerMap.size())).first;
 		}
+		GLfloat sampler{ samplerIt->second };
+
+		// Disabled entities keep their cache entry but aren't copied into the batch
+		chunk.ForEachEnabledRange([&](size_t begin, size_t end)
+		{
+			for (size_t first{ begin }; first < end;)
+			{
+				size_t count{ std::min(end - first, MAX_QUADS - instCount) };
+				for (size_t i{}; i < count; ++i)
+					transforms[instCount + i] = lv[first + i].matrix;
+				std::copy_n(&cache.uvs[first * 4], count * 4, &uvs[instCount * 4]);
+				std::fill_n(&samplers[instCount], count, sampler);
+				instCount += count;
+				first += count;
+
+				// Flush if batch size reached, the bound textures stay valid for the next batch
+				if (instCount >= MAX_QUADS)
+				{
+					ActivateTextureUnits();
+					Flush(instCount);
+					instCount = 0;
+				}
+			}
+		});
+	});
+
+	// Last batch reached
+	if (instCount > 0)
+	{
+		ActivateTextureUnits();
+		Flush(instCount);
 	}
+	texIdToSamplerMap.clear();
+
+	// Drop the caches of chunks that were freed
+	for (auto it{ std::begin(chunkCaches) }; it != std::end(chunkCaches);)
+		it = it->second.frame == frameCount ? std::next(it) : chunkCaches.erase(it);
+
 	glBindVertexArray(0);
 	glUseProgram(0);
 }
 
-/**
- * @brief Calculates the Model-to-World matrix from the Transform component which
- * will be sent to the GPU.
- * @param[in,out] transform A reference to a 3x3 Matrix which will be sent to the GPU.
- * @param[in]     component A read-only reference to the Transform component.
- */
-void QuadInstancedRenderer::CalculateTransform(glm::mat3& transform, Transform const& t)
-{
-	glm::mat3 scale{
-		t.w, 0.f, 0.f,
-		0.f, t.h, 0.f,
-		0.f, 0.f, 1.f
-		};
-	glm::mat3 rotate{
-		cosf(t.a), sinf(t.a), 0.f,
-		-sinf(t.a), cosf(t.a), 0.f,
-		0.f, 0.f, 1.f
-	};
-	glm::mat3 translate{
-		1.f, 0.f, 0.f,
-		0.f, 1.f, 0.f,
-		t.x, t.y, 1.f
-	};
-	transform = translate * rotate * scale;
-}
-
 /**
  * @brief Calculates the UVs for all 4 vertices for each quad, using the given sprite sheet.
  * @param[in,out] uv A pointer to the UV value of the first vertex.
  * @param[in]     component A read-only reference to the SpriteRenderer component.
+ * @param[in]     texture A read-only reference to the sprite sheet, shared by the chunk.
  */
-void QuadInstancedRenderer::CalculateUVs(glm::vec2* uv, SpriteRenderer const& sr)
+void QuadInstancedRenderer::CalculateUVs(glm::vec2* uv, SpriteRenderer const& sr, Texture const& texture)
 {
-	GLfloat w{ static_cast<GLfloat>(sr.cellWidth)  / sr.sprite.mTextureWidth };
-	GLfloat h{ static_cast<GLfloat>(sr.cellHeight) / sr.sprite.mTextureHeight };
+	GLint cellWidth{ sr.cellWidth ? sr.cellWidth : texture.mTextureWidth };
+	GLint cellHeight{ sr.cellHeight ? sr.cellHeight : texture.mTextureHeight };
+	GLfloat w{ static_cast<GLfloat>(cellWidth)  / texture.mTextureWidth };
+	GLfloat h{ static_cast<GLfloat>(cellHeight) / texture.mTextureHeight };
 	GLfloat x = sr.col * w;
 	GLfloat y = sr.row * h;
 
@@ -19,13 +19,16 @@
 #include "Core/Components.hpp"
 #include "Time.hpp"
 
-Transform* transform = nullptr;
-Animator* animator = nullptr;
-
 void Zombie::Start()
 {
-	transform = GetComponent<Transform>(&transform);
-	animator = GetComponent<Animator>(&animator);
+	transform = GetComponent<Transform>();
+	animator = GetComponent<Animator>();
+}
+
+std::unique_ptr<MonoBehaviour> Zombie::Clone() const
+{
+	// References are looked up again in Start()
+	return std::make_unique<Zombie>();
 }
 
 void Zombie::Update()
@@ -22,6 +22,13 @@
 #include "Managers/ArchetypeManager.hpp"
 #include "Time.hpp"
 
+/**
+ * @brief Constructor. Components must be registered before the system is created.
+ */
+AnimatorSystem::AnimatorSystem() :
+	mQuery{ ArchetypeManager::GetInstance().GetQuery<Animator, SpriteRenderer const>() }
+{}
+
 void AnimatorSystem::Init()
 {
 	std::cout << __FUNCTION__ << '\n';
@@ -30,54 +37,72 @@ void AnimatorSystem::Init()
 /**
  * @brief Loops through entities containing an Animator and SpriteRenderer component.
  * Updates the SpriteRenderer's row and column, which decides which sprite to display.
- * Will not update SpriteRenderer if Animator is paused or stopped.
+ * Will not update SpriteRenderer if Animator is paused or stopped, or if the entity is disabled.
  */
 void AnimatorSystem::Update()
 {
-	ArchetypeSet set{ ArchetypeManager::GetInstance().GetArchetypeSet<Animator, SpriteRenderer>() };
-	for (auto& arch : set)
+	ChangeVersion version{ ArchetypeManager::GetInstance().GetVersion() };
+	mQuery.ForEachChunk([version](Chunk& chunk, Animator* av, SpriteRenderer const*)
 	{
-		auto& srv = arch->GetComponentArray<SpriteRenderer>();
-		auto& av = arch->GetComponentArray<Animator>();
-
-		size_t entityCount{ arch->GetEntityCount() };
-		for (size_t i{}; i < entityCount; ++i)
+		// Fetched on the first frame change, so idle chunks keep their SpriteRenderer version
+		SpriteRenderer* srv{ nullptr };
+		chunk.ForEachEnabledRange([&](size_t begin, size_t end)
 		{
-			Animator& animator{ std::any_cast<Animator&>(av[i]) };
-			if (!animator.isPlaying) continue;
+			for (size_t i{ begin }; i < end; ++i)
+			{
+				Animator& animator{ av[i] };
+				if (!animator.isPlaying) continue;
 
-			Animation& animation = animator.GetAnimation(animator.currentAnimation);
-			size_t animFrameCount{ animation.GetFrameCount() };
-			if (animFrameCount <= 0) continue;
+				Animation& animation = animator.GetAnimation(animator.currentAnimation);
+				size_t animFrameCount{ animation.GetFrameCount() };
+				if (animFrameCount <= 0) continue;
 
-			// Maximum loop count reached
-			if (animator.loopCount > 0 && animator.loopsCompleted >= animator.loopCount)
-			{
-				animator.Stop();
-				continue;
-			}
+				// Maximum loop count reached
+				if (animator.loopCount > 0 && animator.loopsCompleted >= animator.loopCount)
+				{
+					animator.Stop();
+					continue;
+				}
 
-			// Frame duration not reached
-			Frame& frame = animation[animator.currentFrameIndex];
-			if (animator.currentFrameTime < frame.duration)
-			{
-				animator.currentFrameTime += static_cast<float>(Time::deltaTime);
-				continue;
-			}
+				// Frame duration not reached
+				Frame& frame = animation[animator.currentFrameIndex];
+				if (animator.currentFrameTime < frame.duration)
+				{
+					animator.currentFrameTime += static_cast<float>(Time::deltaTime);
+					continue;
+				}
+
+				// Go next frame
+				if (srv == nullptr)
+				{
+					srv = chunk.GetComponentArray<SpriteRenderer>();
+					chunk.MarkChanged<SpriteRenderer>(version);
+				}
+				SpriteRenderer& sr{ srv[i] };
+				sr.row = frame.row;
+				sr.col = frame.col;
+				sr.flipX = animator.flipX;
+				sr.flipY = animator.flipY;
 
-			// Go next frame
-			SpriteRenderer& sr{ std::any_cast<SpriteRenderer&>(srv[i]) };
-			sr.row = frame.row;
-			sr.col = frame.col;
-			sr.flipX = animator.flipX;
-			sr.flipY = animator.flipY;
+				int nextFrameIndex{ animator.currentFrameIndex + 1 };
+				animator.currentFrameIndex = nextFrameIndex % animFrameCount;
+				animator.currentFrameTime = 0.f;
 
-			int nextFrameIndex{ animator.currentFrameIndex + 1 };
-			animator.currentFrameIndex = nextFrameIndex % animFrameCount;
-			animator.currentFrameTime = 0.f;
+				if (nextFrameIndex >= animFrameCount)
+					++animator.loopsCompleted;
+			}
+		});
+	});
+}
 
-			if (nextFrameIndex >= animFrameCount)
-				++animator.loopsCompleted;
-		}
-	}
+/**
+ * @brief Writes Animator and SpriteRenderer
+ */
+SystemAccess AnimatorSystem::GetAccess() const
+{
+	ComponentManager& cm{ ComponentManager::GetInstance() };
+	SystemAccess access{};
+	access.writes = cm.GetSignature<Animator>() | cm.GetSignature<SpriteRenderer>();
+	access.isExclusive = false;
+	return access;
 }
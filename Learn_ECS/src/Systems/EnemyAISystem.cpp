@@ -13,34 +13,25 @@ void EnemyAISystem::Init()
 void EnemyAISystem::Update()
 {
 	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	ArchetypeSet set{ am.GetArchetypeSet<Transform, Enemy>() };
-	for (auto& arch : set)
+	am.GetQuery<Transform, Enemy>().ForEach([this](SoARef<Transform> transform, Enemy& en)
 	{
-		auto& tv{ arch->GetComponentArray<Transform>() };
-		auto& enemy{ arch->GetComponentArray<Enemy>() };
-		for (size_t i{}; i < arch->GetEntityCount(); ++i)
-		{
-			Transform& transform{ std::any_cast<Transform&>(tv[i]) };
-			Enemy& en{ std::any_cast<Enemy&>(enemy[i])};
-
-			if (en.pathFOUND) continue;
+		if (en.pathFOUND) return;
 
-			if ((transform.x == en.TargetLocation.first && transform.y == en.TargetLocation.second) || en.openList.empty())
-			{
-				InitAStar(en, transform);
-			}
-			AStar(en, transform);
+		if ((transform.x == en.TargetLocation.first && transform.y == en.TargetLocation.second) || en.openList.empty())
+		{
+			InitAStar(en, transform);
 		}
-	}
+		AStar(en, transform);
+	});
 }
 
-void EnemyAISystem::InitAStar(Enemy& enemy, Transform& transform)
+void EnemyAISystem::InitAStar(Enemy& enemy, SoARef<Transform> transform)
 {
 	Node start{ transform.x, transform.y, nullptr, 0, 0 };
 	enemy.openList.push_back(start);
 	enemy.closedList.clear();
 }
-void EnemyAISystem::AStar(Enemy& enemy, Transform& transform)
+void EnemyAISystem::AStar(Enemy& enemy, SoARef<Transform> transform)
 {
 	while (!enemy.openList.empty())
 	{
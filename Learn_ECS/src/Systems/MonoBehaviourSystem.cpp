@@ -20,39 +20,48 @@
 #include "Managers/ArchetypeManager.hpp"
 
 /**
- * @brief Simply calls Start() of all MonoBehaviours
+ * @brief Constructor. Components must be registered before the system is created.
+ */
+MonoBehaviourSystem::MonoBehaviourSystem() :
+	mQuery{ ArchetypeManager::GetInstance().GetQuery<MonoBehaviour>() }
+{}
+
+/**
+ * @brief Simply calls Start() of all MonoBehaviours, disabled ones included
  */
 void MonoBehaviourSystem::Init()
 {
 	// Oh my god it works
-	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	ArchetypeSet set{ am.GetArchetypeSet<MonoBehaviour>() };
-	for (auto& arch : set)
+	// Disabled scripts start too, so their ComponentRefs are set when they get enabled later.
+	// ForEachChunk skips chunks without enabled entities, so walk the archetypes
+	for (Archetype* archetype : mQuery.GetArchetypes())
 	{
-		auto& mbv{ arch->GetComponentArray<MonoBehaviour>() };
-		for (size_t i{}; i < arch->GetEntityCount(); ++i)
+		for (Chunk& chunk : archetype->GetChunks())
 		{
-			MonoBehaviour* mb{ reinterpret_cast<MonoBehaviour*>(&mbv[i]) };
-			mb->Start();
+			ComponentArray<MonoBehaviour> mbv{ chunk.GetComponentArray<MonoBehaviour>() };
+			for (size_t i{}; i < chunk.GetEntityCount(); ++i)
+				mbv[i]->Start();
 		}
 	}
 }
 
 /**
- * @brief Simply calls Update() of all MonoBehaviours
+ * @brief Simply calls Update() of all enabled MonoBehaviours
  */
 void MonoBehaviourSystem::Update()
 {
 	// Oh my god it works
-	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	ArchetypeSet set{ am.GetArchetypeSet<MonoBehaviour>() };
-	for (auto& arch : set)
+	ChangeVersion version{ ArchetypeManager::GetInstance().GetVersion() };
+	mQuery.ForEachChunk([version](Chunk& chunk, auto* mbv)
 	{
-		auto& mbv{ arch->GetComponentArray<MonoBehaviour>() };
-		for (size_t i{}; i < arch->GetEntityCount(); ++i)
+		chunk.ForEachEnabledRange([&](size_t begin, size_t end)
 		{
-			MonoBehaviour* mb{ reinterpret_cast<MonoBehaviour*>(&mbv[i]) };
-			mb->Update();
-		}
-	}
+			for (size_t i{ begin }; i < end; ++i)
+			{
+				MonoBehaviour* mb{ mbv[i].get() };
+				mb->Update();
+			}
+		});
+		chunk.MarkAllChanged(version);
+	});
 }
@@ -24,6 +24,13 @@
 #include "Managers/ArchetypeManager.hpp"
 #include "Time.hpp"
 
+/**
+ * @brief Constructor. Components must be registered before the system is created.
+ */
+PhysicsSystem::PhysicsSystem() :
+	mQuery{ ArchetypeManager::GetInstance().GetQuery<Transform, Rigidbody2D const>() }
+{}
+
 void PhysicsSystem::Init()
 {
 	std::cout << __FUNCTION__ << '\n';
@@ -31,23 +38,30 @@ void PhysicsSystem::Init()
 
 /**
  * @brief Updates the physical properties of objects like position, velocity, and rotation.
+ * Chunks are split across JobManager's threads. Only the y and a arrays of Transform are loaded.
  */
 void PhysicsSystem::Update()
 {
 #if 1
-	ArchetypeManager& am{ ArchetypeManager::GetInstance() };
-	ArchetypeSet set{ am.GetArchetypeSet<Transform, Rigidbody2D>() };
-	for (auto& arch : set)
+	float deltaTime{ static_cast<float>(Time::deltaTime) };
+	mQuery.ParallelForEachChunk([deltaTime](size_t, Chunk& chunk, SoAArrays<Transform> tv, Rigidbody2D const* rv)
 	{
-		auto& tv{ arch->GetComponentArray<Transform>() };
-		auto& rv{ arch->GetComponentArray<Rigidbody2D>() };
-		for (size_t i{}; i < arch->GetEntityCount(); ++i)
+		chunk.ForEachEnabledRange([&](size_t begin, size_t end)
 		{
-			Transform& transform{ std::any_cast<Transform&>(tv[i]) };
-			Rigidbody2D const& rb{ std::any_cast<Rigidbody2D&>(rv[i]) };
-			transform.y -= rb.vy * static_cast<float>(Time::deltaTime);
-			transform.a += 3.1415f / 4.f * static_cast<float>(Time::deltaTime);
-		}
-	}
+			for (size_t i{ begin }; i < end; ++i)
+			{
+				tv.y[i] -= rv[i].vy * deltaTime;
+				tv.a[i] += 3.1415f / 4.f * deltaTime;
+			}
+		});
+	});
 #endif
 }
+
+/**
+ * @brief Writes Transform, reads Rigidbody2D
+ */
+SystemAccess PhysicsSystem::GetAccess() const
+{
+	return mQuery.GetAccess();
+}
@@ -0,0 +1,186 @@
+/*************************************************************//**
+ * @file   TransformSystem.cpp
+ * @brief  Function definitions of TransformSystem.
+ *
+ * Key features:
+ * Sort the matching chunks by hierarchy depth
+ * Compute the world transform of roots from their Transform
+ * Compute the world transform of children from their parent's LocalToWorld
+ *
+ * Usage:
+ * Called by SystemManager where it loops through all registered
+ * systems and calls their Update() function
+ *
+ * Dependencies:
+ *
+ * @author HONG Xian Xiang
+ * @date   17th October 2026
+ * Copyright 2026, Digipen Institute of Technology
+*****************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "Components/Transform.hpp"
+#include "Components/LocalToWorld.hpp"
+#include "Components/Parent.hpp"
+#include "Systems/TransformSystem.hpp"
+#include "Managers/ArchetypeManager.hpp"
+#include "Managers/ComponentManager.hpp"
+#include "Managers/EntityManager.hpp"
+#include "Managers/JobManager.hpp"
+#include "Managers/SystemManager.hpp"
+
+/**
+ * @brief Constructor. Components must be registered before the system is created.
+ */
+TransformSystem::TransformSystem() :
+	mQuery{ ArchetypeManager::GetInstance().GetQuery<Transform const, LocalToWorld>() }, mChunks{}
+{}
+
+void TransformSystem::Init()
+{
+	std::cout << __FUNCTION__ << '\n';
+}
+
+/**
+ * @brief Computes the LocalToWorld of every entity, one hierarchy level at a time
+ */
+void TransformSystem::Update()
+{
+	// Every archetype has a single depth, so each level is a run of whole chunks once sorted
+	mChunks.clear();
+	for (Archetype* archetype : mQuery.GetArchetypes())
+	{
+		HierarchyDepth const* depth{ archetype->GetSharedComponent<HierarchyDepth>() };
+		for (Chunk& chunk : archetype->GetChunks())
+			mChunks.emplace_back(depth ? depth->depth : 0, &chunk);
+	}
+	std::stable_sort(std::begin(mChunks), std::end(mChunks),
+		[](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+
+	// Disabled entities are computed too, their enabled children still need them
+	ChangeVersion version{ ArchetypeManager::GetInstance().GetVersion() };
+	ChangeVersion lastVersion{ SystemManager::GetLastVersion() };
+	JobManager& jobManager{ JobManager::GetInstance() };
+	for (size_t first{}; first < mChunks.size();)
+	{
+		uint32_t depth{ mChunks[first].first };
+		size_t last{ first };
+		while (last < mChunks.size() && mChunks[last].first == depth) ++last;
+
+		// The previous level is done before this one starts
+		jobManager.ParallelFor(last - first, [&](size_t begin, size_t end)
+		{
+			for (size_t i{ first + begin }; i < first + end; ++i)
+			{
+				Chunk& chunk{ *mChunks[i].second };
+				if (depth == 0 && !chunk.HasChanged<Transform>(lastVersion)) continue;
+
+				SoAArrays<Transform const> tv{ chunk.GetComponentArray<Transform const>() };
+				LocalToWorld* lv{ chunk.GetComponentArray<LocalToWorld>() };
+				chunk.MarkChanged<LocalToWorld>(version);
+				if (depth == 0)
+					UpdateRoots(chunk, tv, lv);
+				else
+					UpdateChildren(chunk, tv, lv);
+			}
+		});
+		first = last;
+	}
+}
+
+/**
+ * @brief Writes LocalToWorld, reads Transform, Parent and HierarchyDepth
+ */
+SystemAccess TransformSystem::GetAccess() const
+{
+	ComponentManager& cm{ ComponentManager::GetInstance() };
+	SystemAccess access{};
+	access.reads = cm.GetSignature<Transform>() | cm.GetSignature<Parent>() | cm.GetSignature<HierarchyDepth>();
+	access.writes = cm.GetSignature<LocalToWorld>();
+	access.isExclusive = false;
+	return access;
+}
+
+/**
+ * @brief Compute the LocalToWorld of the entities of a root chunk
+ */
+void TransformSystem::UpdateRoots(Chunk& chunk, SoAArrays<Transform const> tv, LocalToWorld* lv)
+{
+	size_t entityCount{ chunk.GetEntityCount() };
+	for (size_t i{}; i < entityCount; ++i)
+	{
+		LocalToWorld& localToWorld{ lv[i] };
+		localToWorld.x = tv.x[i];
+		localToWorld.y = tv.y[i];
+		localToWorld.a = tv.a[i];
+		CalculateMatrix(localToWorld, tv.w[i], tv.h[i]);
+	}
+}
+
+/**
+ * @brief Compute the LocalToWorld of the entities of a child chunk, relative to their parents
+ */
+void TransformSystem::UpdateChildren(Chunk& chunk, SoAArrays<Transform const> tv, LocalToWorld* lv)
+{
+	Archetype* archetype{ chunk.GetArchetype() };
+	size_t parentColumn{ archetype->GetColumnIndex(ComponentManager::GetComponentIndex<Parent>()) };
+	if (parentColumn == Archetype::INVALID_COLUMN)
+	{
+		UpdateRoots(chunk, tv, lv);
+		return;
+	}
+
+	// Parents are at a lower depth, so in chunks that are already done and not written by this level
+	EntityManager& em{ EntityManager::GetInstance() };
+	size_t localToWorldIndex{ ComponentManager::GetComponentIndex<LocalToWorld>() };
+	Parent const* pv{ static_cast<Parent const*>(chunk.GetComponentAddress(0, parentColumn)) };
+	size_t entityCount{ chunk.GetEntityCount() };
+	for (size_t i{}; i < entityCount; ++i)
+	{
+		LocalToWorld& localToWorld{ lv[i] };
+
+		// A destroyed parent, or one without a LocalToWorld, leaves the child in world space
+		LocalToWorld const* parent{ nullptr };
+		EntityId parentId{ pv[i].parentId };
+		if (em.IsAlive(parentId))
+		{
+			EntityRecord const& record{ em.GetRecord(parentId) };
+			size_t column{ record.archetype ? record.archetype->GetColumnIndex(localToWorldIndex) : Archetype::INVALID_COLUMN };
+			if (column != Archetype::INVALID_COLUMN)
+				parent = static_cast<LocalToWorld const*>(record.archetype->GetComponentAddress(record.row, column));
+		}
+
+		if (parent)
+		{
+			float c{ cosf(parent->a) };
+			float s{ sinf(parent->a) };
+			localToWorld.x = parent->x + c * tv.x[i] - s * tv.y[i];
+			localToWorld.y = parent->y + s * tv.x[i] + c * tv.y[i];
+			localToWorld.a = parent->a + tv.a[i];
+		}
+		else
+		{
+			localToWorld.x = tv.x[i];
+			localToWorld.y = tv.y[i];
+			localToWorld.a = tv.a[i];
+		}
+		CalculateMatrix(localToWorld, tv.w[i], tv.h[i]);
+	}
+}
+
+/**
+ * @brief Fill the matrix of a LocalToWorld from its world position and angle, and the size (w, h) of the Transform
+ */
+void TransformSystem::CalculateMatrix(LocalToWorld& localToWorld, float w, float h)
+{
+	// Translate * Rotate * Scale, written out
+	float c{ cosf(localToWorld.a) };
+	float s{ sinf(localToWorld.a) };
+	localToWorld.matrix = glm::mat3{
+		c * w, s * w, 0.f,
+		-s * h, c * h, 0.f,
+		localToWorld.x, localToWorld.y, 1.f
+	};
+}